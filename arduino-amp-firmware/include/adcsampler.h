@@ -0,0 +1,48 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_ADC_SAMPLER_HEADER_
+#define _ARDUINO_AMP_ADC_SAMPLER_HEADER_
+
+#include "common.h"
+
+// ADC clock prescaler values (ADPS2:0). In free-running mode one conversion takes 13 ADC 
+// clock cycles, so with 16MHz system clock these give the following fixed sample rates.
+#define ADC_PRESCALER_16    0x04    // 76.9kHz
+#define ADC_PRESCALER_32    0x05    // 38.5kHz
+#define ADC_PRESCALER_64    0x06    // 19.2kHz
+#define ADC_PRESCALER_128   0x07    // 9.6kHz
+
+#define ADC_SAMPLE_RATE(prescaler)  (F_CPU / ((1UL << (prescaler)) * 13UL))
+
+void initAudioSampler(unsigned char prescaler);
+
+#if ANALYZER_ENGINE != ANALYZER_ENGINE_GOERTZEL_ISR
+// Copy the latest frame (overlapped by 50% with the previous frame) into the given buffer, with 
+// the window function applied. Returns FALSE if no new samples are available.
+unsigned char getSampleFrame(short *frame);
+#endif
+
+#endif /* _ARDUINO_AMP_ADC_SAMPLER_HEADER_ */
@@ -0,0 +1,52 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_ARENA_HEADER_
+#define _ARDUINO_AMP_ARENA_HEADER_
+
+#include "common.h"
+
+// Shared SRAM arena. The analyzer scratch buffers are used only inside the analyzer task, other 
+// modules may overlay their buffers in the union while the analyzer is stopped.
+typedef struct AnalyzerScratch
+{
+#if ANALYZER_ENGINE != ANALYZER_ENGINE_GOERTZEL_ISR
+    // Work buffer, the latest overlapped frame is copied here from the sample ring.
+    short frame[ANALYZER_SAMPLES];
+#endif
+#if ANALYZER_ENGINE == ANALYZER_ENGINE_FFT
+    // FFT bin magnitudes, until they are grouped into bands.
+    unsigned short bins[ANALYZER_BINS];
+#endif
+} AnalyzerScratch;
+
+typedef union SharedArena
+{
+    AnalyzerScratch analyzer;
+} SharedArena;
+
+extern SharedArena sharedArena;
+
+#endif /* _ARDUINO_AMP_ARENA_HEADER_ */
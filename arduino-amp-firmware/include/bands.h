@@ -0,0 +1,47 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_BANDS_HEADER_
+#define _ARDUINO_AMP_BANDS_HEADER_
+
+#include "common.h"
+#include "adcsampler.h"
+
+// Band aggregation modes.
+#define BAND_MODE_PEAK  0x00
+#define BAND_MODE_SUM   0x01
+
+// Maximum number of bands supported by the bin range table.
+#define BAND_MAX_COLUMNS    16
+
+#define ANALYZER_SAMPLE_RATE    ADC_SAMPLE_RATE(ANALYZER_ADC_PRESCALER)
+
+void aggregateBands(const unsigned short *magnitude, unsigned short *bands);
+
+// Exponential averaging of the band magnitudes across the analyzer frames.
+void averageBands(const unsigned short *bands);
+void getAverageBands(unsigned short *bands);
+
+#endif /* _ARDUINO_AMP_BANDS_HEADER_ */
@@ -0,0 +1,47 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_BAR_GRAPH_HEADER_
+#define _ARDUINO_AMP_BAR_GRAPH_HEADER_
+
+#include "common.h"
+
+// Bar heights in display levels (8 pixel rows in each of the 2 LCD rows).
+#define BAR_GRAPH_MAX_HEIGHT    16
+
+// Custom character slots: 1-7 are partially filled cells, 0 is the peak-hold marker.
+#define BAR_GRAPH_PEAK_GLYPH    0x00
+#define BAR_GRAPH_FULL_GLYPH    0xFF
+
+void initBarGraph();
+void resetBarGraph();
+
+// Move the bars and the peak markers towards the given levels (called once per render frame).
+void updateBarGraph(const unsigned short *levels);
+
+// Render the bar graph into all cells of the frame buffer.
+void drawBarGraph();
+
+#endif /* _ARDUINO_AMP_BAR_GRAPH_HEADER_ */
@@ -0,0 +1,70 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_BUTTONS_HEADER_
+#define _ARDUINO_AMP_BUTTONS_HEADER_
+
+#include "common.h"
+
+// Button identifiers.
+#define BUTTON_ACTION   0x00
+#define BUTTON_UP       0x01
+#define BUTTON_DOWN     0x02
+#define BUTTON_MUTE     0x03
+
+#define BUTTON_COUNT    4
+
+// Button event types. Up, down and mute buttons act on PRESS (the old polling firmware acted on 
+// release), action button acts on RELEASE so a LONG_PRESS can be told apart from a short press.
+#define BUTTON_EVENT_NONE       0x00
+#define BUTTON_EVENT_PRESS      0x10
+#define BUTTON_EVENT_RELEASE    0x20
+#define BUTTON_EVENT_LONG_PRESS 0x30
+#define BUTTON_EVENT_REPEAT     0x40
+
+#define BUTTON_EVENT_ID(event)      ((event) & 0x0F)
+#define BUTTON_EVENT_TYPE(event)    ((event) & 0xF0)
+
+// Debounce and long press timing (in system ticks, ~1ms).
+#define BUTTON_DEBOUNCE_TIME    20
+#define BUTTON_LONG_PRESS_TIME  1000
+
+// Auto-repeat of the held buttons (in system ticks): first repeat after the initial delay, then 
+// each repeat interval is shortened by 1/2^ACCEL_SHIFT until it reaches the minimum interval.
+#define BUTTON_REPEAT_DELAY         400
+#define BUTTON_REPEAT_INTERVAL      150
+#define BUTTON_REPEAT_MIN_INTERVAL  25
+#define BUTTON_REPEAT_ACCEL_SHIFT   3
+
+// Buttons with auto-repeat (bit per button identifier).
+#define BUTTON_REPEAT_MASK  (_BV(BUTTON_UP) | _BV(BUTTON_DOWN))
+
+// Size of the event queue, must be a power of 2.
+#define BUTTON_QUEUE_SIZE   8
+
+void initButtons();
+unsigned char getButtonEvent();
+
+#endif /* _ARDUINO_AMP_BUTTONS_HEADER_ */
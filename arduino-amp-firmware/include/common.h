@@ -49,9 +49,109 @@
 #define AUDIO_OUT_SPEAKER   0x00
 #define AUDIO_OUT_HEADPHONE 0x01
 
-#define IDLE_TIMEOUT        300
-#define IDLE_MENU_TIMEOUT   400
+#define UI_MODE_NORMAL      0x00
+#define UI_MODE_SETTINGS    0x01
+#define UI_MODE_DIAGNOSTICS 0x02
 
+// Timeouts and service task intervals (in milliseconds).
+#define IDLE_TIMEOUT        15000
+#define IDLE_MENU_TIMEOUT   20000
+#define SAVE_CONFIG_DELAY   (IDLE_TIMEOUT / 2)
+
+#define BUTTON_EVENT_INTERVAL   5
+#define ANALYZER_FRAME_INTERVAL 2
+#define ANALYZER_RENDER_INTERVAL    40
+#define VOLUME_RAMP_INTERVAL    4
+#define REMOTE_POLL_INTERVAL    5
+#define DIAGNOSTICS_INTERVAL    500
+
+// Spectrum analyzer resolution. Real input samples are packed into a half-size complex FFT, 
+// high resolution mode gives 128 frequency bins and fast mode gives 64 bins with half the cycles.
+// Sample ring (1.5 frames), work frame and FFT bins take 768 bytes in fast mode and 1.5KB in 
+// high resolution mode, so high resolution mode fits only with the Goertzel ISR engine.
+#define ANALYZER_FFT_HIGH_RES   0x00
+#define ANALYZER_FFT_FAST       0x01
+
+#define ANALYZER_FFT_MODE       ANALYZER_FFT_FAST
+
+#if ANALYZER_FFT_MODE == ANALYZER_FFT_HIGH_RES
+#define ANALYZER_SAMPLES        256
+#else
+#define ANALYZER_SAMPLES        128
+#endif
+
+#define ANALYZER_BINS           (ANALYZER_SAMPLES / 2)
+
+// Spectrum analyzer sampling configuration.
+#define ANALYZER_ADC_PRESCALER  ADC_PRESCALER_64
+#define ANALYZER_ADC_RESOLUTION 10
+
+// Spectrum analyzer bands: number of LCD columns, frequency range (in Hz) and the aggregation 
+// mode of the FFT bins in each band (see bands.h).
+#define ANALYZER_COLUMNS        16
+#define ANALYZER_BAND_MIN_FREQ  60
+#define ANALYZER_BAND_MAX_FREQ  9600
+#define ANALYZER_BAND_MODE      BAND_MODE_PEAK
+
+// Spectrum analyzer engine. FFT engine computes all frequency bins and groups them into bands, 
+// Goertzel engine computes only the band center frequencies. Goertzel filters can run on the 
+// captured frames or on each sample in the ADC ISR (needs ADC_PRESCALER_128, see goertzel.h).
+#define ANALYZER_ENGINE_FFT             0x00
+#define ANALYZER_ENGINE_GOERTZEL        0x01
+#define ANALYZER_ENGINE_GOERTZEL_ISR    0x02
+
+#define ANALYZER_ENGINE         ANALYZER_ENGINE_FFT
+
+// SRAM budget of the analyzer buffers: 16-bit sample ring of 3 half frames, work frame and 
+// 16-bit FFT bins (see adcsampler.cpp and arena.h). Goertzel ISR engine keeps no frames.
+#define ANALYZER_RAM_BUDGET     1024
+
+#if ANALYZER_ENGINE == ANALYZER_ENGINE_GOERTZEL_ISR
+#define ANALYZER_RAM_USAGE      0
+#elif ANALYZER_ENGINE == ANALYZER_ENGINE_GOERTZEL
+#define ANALYZER_RAM_USAGE      ((3 * (ANALYZER_SAMPLES / 2) * 2) + (ANALYZER_SAMPLES * 2))
+#else
+#define ANALYZER_RAM_USAGE      ((3 * (ANALYZER_SAMPLES / 2) * 2) + (ANALYZER_SAMPLES * 2) + (ANALYZER_BINS * 2))
+#endif
+
+#if ANALYZER_RAM_USAGE > ANALYZER_RAM_BUDGET
+#error "Analyzer buffers do not fit into SRAM, use ANALYZER_FFT_FAST or the Goertzel ISR engine"
+#endif
+
+// Exponential averaging of the band magnitudes between the frames, each new frame is weighted 
+// by 1/2^ANALYZER_AVERAGE_SHIFT (0 disables the averaging).
+#define ANALYZER_AVERAGE_SHIFT  2
+
+// Spectrum analyzer bar dynamics: on each render frame bars rise by 1/2^ATTACK_SHIFT and fall by 
+// 1/2^DECAY_SHIFT of the distance to the new level. Peak markers are held for ANALYZER_PEAK_HOLD 
+// (in milliseconds) and then fall by ANALYZER_PEAK_DECAY (in 1/16 levels) per frame.
+#define ANALYZER_ATTACK_SHIFT   1
+#define ANALYZER_DECAY_SHIFT    3
+#define ANALYZER_PEAK_HOLD      800
+#define ANALYZER_PEAK_DECAY     4
+
+// Automatic gain control: the smoothed peak level of the bands is kept ANALYZER_AGC_HEADROOM 
+// levels below the top of the bar graph. On each render frame the level tracker rises by 
+// 1/2^ATTACK_SHIFT and falls by 1/2^RELEASE_SHIFT of the difference. Gain limits are in 1/16 
+// octaves (~0.38dB).
+#define ANALYZER_AGC_HEADROOM       2
+#define ANALYZER_AGC_ATTACK_SHIFT   1
+#define ANALYZER_AGC_RELEASE_SHIFT  5
+#define ANALYZER_AGC_MAX_GAIN       64
+#define ANALYZER_AGC_MIN_GAIN       (-32)
+
+// Window function applied to the captured samples (see window.h).
+#define ANALYZER_WINDOW         WINDOW_HANN
+
+// Cycle profiler of the analyzer pipeline (see profiler.h), enabled with -DENABLE_PROFILER=1 in 
+// the build flags (profiler environment in platformio.ini). Statistics are shown in the 
+// diagnostics screen, opened by a long press of the action button.
+#ifndef ENABLE_PROFILER
+#define ENABLE_PROFILER     0
+#endif
+
+// Fixed EEPROM layout of the old firmware versions, settings are now stored in a record log 
+// (see configstore.h) and this layout is only read if the log is empty.
 #define EEPROM_ADDR_VOLUME  0x00
 #define EEPROM_ADDR_BASS    0x01
 #define EEPROM_ADDR_TREBLE  0x02
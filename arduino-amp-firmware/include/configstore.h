@@ -0,0 +1,66 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_CONFIG_STORE_HEADER_
+#define _ARDUINO_AMP_CONFIG_STORE_HEADER_
+
+#include "common.h"
+
+// Settings are stored as a log of fixed size records across the whole EEPROM. Each save appends 
+// a new record after the newest one (wrapping around), so the writes are spread over all slots.
+#define CONFIG_RECORD_VERSION   0x01
+#define CONFIG_RECORD_INVALID   0x00
+#define CONFIG_RECORD_SIZE      8
+#define CONFIG_STORE_SLOTS      ((E2END + 1) / CONFIG_RECORD_SIZE)
+
+#define CONFIG_SLOT_NONE        0xFF
+
+// EEPROM writes of a record: version invalidation followed by the whole record.
+#define CONFIG_RECORD_WRITES    (CONFIG_RECORD_SIZE + 1)
+
+typedef struct ConfigRecord
+{
+    unsigned char sequence;
+    AudioSettings settings;
+    unsigned char outputMode;
+    unsigned char version;
+    unsigned char crc;
+} ConfigRecord;
+
+// Scan the EEPROM and locate the newest valid record.
+void initConfigStore();
+
+// Returns FALSE if there is no valid record in the store.
+unsigned char readConfigRecord(AudioSettings *settings, unsigned char *outputMode);
+
+// Append a new record, unless the settings are the same as in the newest record. Record is 
+// posted to the EEPROM write queue and this returns without waiting for the write. If the queue 
+// has no room for the whole record, the record is kept pending for flushConfigStore.
+void writeConfigRecord(const AudioSettings *settings, unsigned char outputMode);
+
+// Post the pending record once the EEPROM write queue has room for it, called from the main loop.
+void flushConfigStore();
+
+#endif /* _ARDUINO_AMP_CONFIG_STORE_HEADER_ */
@@ -0,0 +1,82 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_CONST_MATH_HEADER_
+#define _ARDUINO_AMP_CONST_MATH_HEADER_
+
+// Compile-time math helpers used to generate lookup tables (C++11 constexpr, no runtime cost).
+
+#define CONST_PI    3.14159265358979323846
+
+constexpr unsigned char constMaxU8(unsigned char a, unsigned char b)
+{
+    return (a > b) ? a : b;
+}
+
+constexpr unsigned char constMinU8(unsigned char a, unsigned char b)
+{
+    return (a < b) ? a : b;
+}
+
+constexpr double constMin(double a, double b)
+{
+    return (a < b) ? a : b;
+}
+
+constexpr double constPower(double base, unsigned char exponent)
+{
+    return (exponent == 0) ? 1.0 : (base * constPower(base, exponent - 1));
+}
+
+// N-th root with Newton's iteration.
+constexpr double constRoot(double value, unsigned char n, double guess, unsigned char iteration)
+{
+    return (iteration == 0) ? guess : constRoot(value, n, (((n - 1) * guess) + (value / constPower(guess, n - 1))) / n, iteration - 1);
+}
+
+// Taylor series of sin(x), accurate for |x| <= PI.
+constexpr double constSinSeries(double xSquare, double term, unsigned char k, double sum)
+{
+    return (k > 16) ? sum : constSinSeries(xSquare, -term * xSquare / ((2 * k + 2) * (2 * k + 3)), k + 1, sum + term);
+}
+
+constexpr double constSin(double x)
+{
+    return constSinSeries(x * x, x, 0, 0.0);
+}
+
+constexpr double constCos(double x)
+{
+    return constSin((CONST_PI / 2) - x);
+}
+
+// Round to signed Q15 with saturation.
+constexpr short constQ15(double value)
+{
+    return (value >= (32767.0 / 32768.0)) ? 32767 : ((value <= -1.0) ? -32768 : 
+        (short)((value * 32768.0) + ((value >= 0) ? 0.5 : -0.5)));
+}
+
+#endif /* _ARDUINO_AMP_CONST_MATH_HEADER_ */
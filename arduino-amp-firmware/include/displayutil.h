@@ -27,10 +27,18 @@
 #define _ARDUINO_AMP_DISPLAY_UTIL_HEADER_
 
 #include "common.h"
+#include "profiler.h"
 
 void clearRow(unsigned char row);
 void displayVolumeLevel(unsigned char lvlVolume);
 void displayMenuItem(SettingsMenuState *menuState, AudioSettings *audioSettings, unsigned char *outputMode);
 void showMute();
 
+#if ENABLE_PROFILER
+// Page 0 shows the frame rates, the following pages show the profiled stages.
+#define DIAGNOSTICS_PAGE_COUNT  (PROFILE_STAGE_COUNT + 1)
+
+void displayDiagnostics(unsigned char page);
+#endif
+
 #endif/* _ARDUINO_AMP_DISPLAY_UTIL_HEADER_ */
\ No newline at end of file
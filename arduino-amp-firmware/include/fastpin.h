@@ -0,0 +1,118 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_FAST_PIN_HEADER_
+#define _ARDUINO_AMP_FAST_PIN_HEADER_
+
+#include <Arduino.h>
+
+// I/O port identifiers of the ATmega328P (Arduino Nano pin mapping).
+#define FASTPIN_PORT_B  0x01
+#define FASTPIN_PORT_C  0x02
+#define FASTPIN_PORT_D  0x03
+
+constexpr unsigned char fastPinPort(unsigned char pin)
+{
+    return (pin < 8) ? FASTPIN_PORT_D : ((pin < 14) ? FASTPIN_PORT_B : FASTPIN_PORT_C);
+}
+
+constexpr unsigned char fastPinBit(unsigned char pin)
+{
+    return (pin < 8) ? pin : ((pin < 14) ? (pin - 8) : (pin - 14));
+}
+
+// Digital I/O pin with port and bit mask resolved at compile time. With constant register 
+// addresses the compiler emits single SBI / CBI / SBIS instructions for these operations.
+template<unsigned char PIN>
+class FastPin
+{
+public:
+    static_assert(PIN < 20, "Pin is not available on ATmega328P");
+
+    static constexpr unsigned char portId = fastPinPort(PIN);
+    static constexpr unsigned char bit = fastPinBit(PIN);
+    static constexpr unsigned char mask = (1 << fastPinBit(PIN));
+
+    static inline volatile unsigned char &port() __attribute__((always_inline))
+    {
+        return (portId == FASTPIN_PORT_D) ? PORTD : ((portId == FASTPIN_PORT_B) ? PORTB : PORTC);
+    }
+
+    static inline volatile unsigned char &ddr() __attribute__((always_inline))
+    {
+        return (portId == FASTPIN_PORT_D) ? DDRD : ((portId == FASTPIN_PORT_B) ? DDRB : DDRC);
+    }
+
+    static inline volatile unsigned char &pin() __attribute__((always_inline))
+    {
+        return (portId == FASTPIN_PORT_D) ? PIND : ((portId == FASTPIN_PORT_B) ? PINB : PINC);
+    }
+
+    static inline void setOutput() __attribute__((always_inline))
+    {
+        ddr() |= mask;
+    }
+
+    static inline void setInput() __attribute__((always_inline))
+    {
+        ddr() &= ~mask;
+        port() &= ~mask;
+    }
+
+    static inline void setInputPullup() __attribute__((always_inline))
+    {
+        ddr() &= ~mask;
+        port() |= mask;
+    }
+
+    static inline void high() __attribute__((always_inline))
+    {
+        port() |= mask;
+    }
+
+    static inline void low() __attribute__((always_inline))
+    {
+        port() &= ~mask;
+    }
+
+    static inline void write(unsigned char state) __attribute__((always_inline))
+    {
+        if(state)
+        {
+            high();
+        }
+        else
+        {
+            low();
+        }
+    }
+
+    static inline unsigned char read() __attribute__((always_inline))
+    {
+        return (pin() & mask) ? HIGH : LOW;
+    }
+};
+
+#endif /* _ARDUINO_AMP_FAST_PIN_HEADER_ */
@@ -0,0 +1,50 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_GOERTZEL_HEADER_
+#define _ARDUINO_AMP_GOERTZEL_HEADER_
+
+#include "common.h"
+#include "adcsampler.h"
+
+// Each filter update takes about 70 cycles, so the per-sample ISR engine uses ~1100 cycles of 
+// every sample period. This fits only at the lowest ADC sample rate (1664 cycles per sample).
+#if (ANALYZER_ENGINE == ANALYZER_ENGINE_GOERTZEL_ISR) && (ANALYZER_ADC_PRESCALER != ADC_PRESCALER_128)
+#error "Goertzel ISR engine needs ADC_PRESCALER_128"
+#endif
+
+#define GOERTZEL_BANDS  ANALYZER_COLUMNS
+
+// Process a captured frame (deinterleaved as stored by the ADC sampler) and compute the 
+// magnitude of each band.
+void computeGoertzel(short *samples, unsigned short *bands);
+
+// Per-sample engine: updateGoertzel and latchGoertzel are called from the ADC ISR, 
+// getGoertzelBands returns TRUE if a new frame is available and computes the band magnitudes.
+void updateGoertzel(short sample);
+void latchGoertzel();
+unsigned char getGoertzelBands(unsigned short *bands);
+
+#endif /* _ARDUINO_AMP_GOERTZEL_HEADER_ */
@@ -0,0 +1,67 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_I2C_QUEUE_HEADER_
+#define _ARDUINO_AMP_I2C_QUEUE_HEADER_
+
+#define I2C_CLOCK_FREQ  100000UL
+
+// Size of the transaction queue (must be a power of 2) and maximum payload of a transaction.
+#define I2C_QUEUE_SIZE      8
+#define I2C_MAX_DATA_SIZE   4
+
+// Transaction status codes.
+#define I2C_STATUS_OK               0x00
+#define I2C_STATUS_ADDR_NACK        0x01
+#define I2C_STATUS_DATA_NACK        0x02
+#define I2C_STATUS_ARBITRATION_LOST 0x03
+#define I2C_STATUS_BUS_ERROR        0x04
+#define I2C_STATUS_INVALID          0x05
+#define I2C_STATUS_BUSY             0x06
+#define I2C_STATUS_TIMEOUT          0x07
+
+// Active transaction is aborted and the bus is reset if the TWI makes no progress in this time 
+// (in milliseconds).
+#define I2C_TIMEOUT         10
+
+// Number of SCL pulses to release a slave which holds SDA low.
+#define I2C_RECOVERY_CLOCKS 9
+
+// Callbacks are invoked from the TWI interrupt context.
+typedef void (*I2CCallback)(unsigned char address, unsigned char subAddr, unsigned char status);
+
+void initI2CQueue();
+void setI2CCallbacks(I2CCallback onComplete, I2CCallback onError);
+
+// Queue a write and return immediately. A pending write to the same registers is updated in place 
+// if it is the latest pending write to the device (so the write order of the device is kept). 
+// Returns I2C_STATUS_BUSY if the queue is full, nothing is queued in that case.
+unsigned char i2cWrite(unsigned char address, unsigned char subAddr, const unsigned char *data, unsigned char length);
+unsigned char isI2CQueueIdle();
+
+// Check the active transaction for a hung bus, called from the main loop.
+void serviceI2CQueue();
+
+#endif /* _ARDUINO_AMP_I2C_QUEUE_HEADER_ */
@@ -0,0 +1,47 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_LCD_DRIVER_HEADER_
+#define _ARDUINO_AMP_LCD_DRIVER_HEADER_
+
+// HD44780 commands.
+#define LCD_CMD_CLEAR           0x01
+#define LCD_CMD_ENTRY_MODE      0x06    // Increment address, no display shift.
+#define LCD_CMD_DISPLAY_ON      0x0C    // Display on, cursor and blink off.
+#define LCD_CMD_FUNCTION_SET    0x28    // 4-bit interface, 2 lines, 5x8 font.
+#define LCD_CMD_SET_CGRAM_ADDR  0x40
+#define LCD_CMD_SET_DDRAM_ADDR  0x80
+
+#define LCD_ROW1_ADDR   0x40
+
+void lcdInit();
+void lcdClear();
+void lcdSetCursor(unsigned char col, unsigned char row);
+void lcdWrite(unsigned char value);
+
+// Character map of the custom character is read from the program memory.
+void lcdCreateChar(unsigned char location, const unsigned char *charMap);
+
+#endif /* _ARDUINO_AMP_LCD_DRIVER_HEADER_ */
@@ -0,0 +1,60 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_LCD_FRAME_HEADER_
+#define _ARDUINO_AMP_LCD_FRAME_HEADER_
+
+#include "common.h"
+
+#include <Print.h>
+
+#define LCD_COLUMNS 16
+#define LCD_ROWS    2
+
+// Cursor position which is not known to the frame buffer.
+#define LCD_CURSOR_UNKNOWN  0xFF
+
+class LCDFrameBuffer : public Print
+{
+public:
+    LCDFrameBuffer();
+
+    void begin();
+    void clear();
+    void setCursor(unsigned char col, unsigned char row);    
+    virtual size_t write(uint8_t value);
+    virtual void flush();
+
+    using Print::write;
+
+private:
+    // Frame rendered by the firmware and the content which is currently on the LCD.
+    unsigned char frame[LCD_ROWS][LCD_COLUMNS];
+    unsigned char shadow[LCD_ROWS][LCD_COLUMNS];
+
+    unsigned char cursorCol, cursorRow;
+};
+
+#endif /* _ARDUINO_AMP_LCD_FRAME_HEADER_ */
@@ -0,0 +1,90 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_PROFILER_HEADER_
+#define _ARDUINO_AMP_PROFILER_HEADER_
+
+#include "common.h"
+
+// Profiled stages of the analyzer pipeline and the main loop.
+#define PROFILE_CAPTURE     0x00
+#define PROFILE_TRANSFORM   0x01
+#define PROFILE_BANDS       0x02
+#define PROFILE_STREAM      0x03
+#define PROFILE_AGC         0x04
+#define PROFILE_LEVELS      0x05
+#define PROFILE_BARGRAPH    0x06
+#define PROFILE_LCD         0x07
+#define PROFILE_LOOP        0x08
+
+#define PROFILE_STAGE_COUNT 9
+
+// Frame counters.
+#define PROFILE_ANALYZER_FRAME  0x00
+#define PROFILE_RENDER_FRAME    0x01
+
+#define PROFILE_COUNTER_COUNT   2
+
+// Timer1 runs with clk/8 prescaler, so each tick is 8 CPU cycles (32ms range).
+#define PROFILE_CYCLES_PER_TICK 8
+
+#if ENABLE_PROFILER
+
+#include <avr/io.h>
+
+typedef struct
+{
+    unsigned short minTicks;
+    unsigned short avgTicks;
+    unsigned short maxTicks;
+    unsigned short count;
+} ProfileStats;
+
+// Timer1 is taken over by the profiler, it must not be used for PWM or by the other modules.
+void initProfiler();
+void resetProfiler();
+
+// Record the time elapsed since the start ticks, returns the current ticks (start of the next stage).
+unsigned short recordProfileStage(unsigned char stage, unsigned short startTicks);
+void countProfileFrame(unsigned char counter);
+
+// Statistics since the last reset, frame rate is in 0.1 frames per second.
+void getProfileStats(unsigned char stage, ProfileStats *stats);
+unsigned short getProfileFrameRate(unsigned char counter);
+
+// Instrumentation of the code, consecutive stages share the same mark.
+#define PROFILE_START(mark)         unsigned short mark = TCNT1
+#define PROFILE_STAGE(stage, mark)  mark = recordProfileStage((stage), (mark))
+#define PROFILE_FRAME(counter)      countProfileFrame(counter)
+
+#else
+
+#define PROFILE_START(mark)
+#define PROFILE_STAGE(stage, mark)
+#define PROFILE_FRAME(counter)
+
+#endif /* ENABLE_PROFILER */
+
+#endif /* _ARDUINO_AMP_PROFILER_HEADER_ */
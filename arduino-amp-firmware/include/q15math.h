@@ -0,0 +1,80 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_Q15_MATH_HEADER_
+#define _ARDUINO_AMP_Q15_MATH_HEADER_
+
+#include <stdint.h>
+
+// Signed Q15 fractional multiplication: (a * b) >> 15.
+static inline int16_t mulQ15(int16_t a, int16_t b) __attribute__((always_inline));
+
+static inline int16_t mulQ15(int16_t a, int16_t b)
+{
+#if defined(__AVR_HAVE_MUL__)
+    int16_t result;
+    uint8_t lowByte, zero;
+
+    // 16x16 fractional multiplication with the hardware multiplier (based on Atmel AVR201), 
+    // only the upper word of the Q31 product is kept.
+    asm volatile(
+        "clr %[zero]                \n\t"
+        "fmuls %B[a], %B[b]         \n\t"   // (ah * bh) << 1
+        "movw %A[result], r0        \n\t"
+        "fmul %A[a], %A[b]          \n\t"   // (al * bl) << 1
+        "adc %A[result], %[zero]    \n\t"
+        "mov %[low], r1             \n\t"
+        "fmulsu %B[a], %A[b]        \n\t"   // (ah * bl) << 1
+        "sbc %B[result], %[zero]    \n\t"
+        "add %[low], r0             \n\t"
+        "adc %A[result], r1         \n\t"
+        "adc %B[result], %[zero]    \n\t"
+        "fmulsu %B[b], %A[a]        \n\t"   // (bh * al) << 1
+        "sbc %B[result], %[zero]    \n\t"
+        "add %[low], r0             \n\t"
+        "adc %A[result], r1         \n\t"
+        "adc %B[result], %[zero]    \n\t"
+        "clr __zero_reg__           \n\t"
+        : [result] "=&r" (result), [low] "=&r" (lowByte), [zero] "=&r" (zero)
+        : [a] "a" (a), [b] "a" (b)
+    );
+
+    return result;
+#else
+    return (int16_t)(((int32_t)a * b) >> 15);
+#endif
+}
+
+// Multiply a 32-bit value by a signed 16-bit fraction and keep the upper bits: (a * b) >> 16. 
+// The value is split into the signed upper and unsigned lower words, so both products use the 
+// 16x16 hardware multiplier instead of the 32-bit multiplication routine.
+static inline int32_t mulLongHigh(int32_t a, int16_t b) __attribute__((always_inline));
+
+static inline int32_t mulLongHigh(int32_t a, int16_t b)
+{
+    return ((int32_t)(int16_t)(a >> 16) * b) + (int16_t)(((int32_t)(uint16_t)a * b) >> 16);
+}
+
+#endif /* _ARDUINO_AMP_Q15_MATH_HEADER_ */
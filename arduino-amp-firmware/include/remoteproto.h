@@ -0,0 +1,100 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_REMOTE_PROTO_HEADER_
+#define _ARDUINO_AMP_REMOTE_PROTO_HEADER_
+
+// Binary control protocol on the UART (see tools/ampproto.py for the host side). Each frame is:
+//
+//   SYNC | LEN | CMD | REQID | PAYLOAD (LEN bytes) | CRC8
+//
+// CRC8 (polynomial 0x07, initial value 0) covers LEN, CMD, REQID and the payload. Response to a 
+// request has the REMOTE_RESPONSE bit set in CMD, the same REQID and the status code as the 
+// first payload byte. Frames with a wrong CRC are dropped without a response. UART runs at 
+// UART_BAUD_RATE, which depends on the analyzer engine (see uart.h).
+#define REMOTE_SYNC         0xA5
+#define REMOTE_MAX_PAYLOAD  40
+#define REMOTE_FRAME_OVERHEAD   5
+
+// Requests and their responses are shorter than the frames sent by the device, this limits the 
+// receive buffer of the parser.
+#define REMOTE_MAX_REQUEST  16
+
+// Partially received frame is discarded if the next byte does not arrive in time (in milliseconds).
+#define REMOTE_FRAME_TIMEOUT    50
+
+#define REMOTE_RESPONSE     0x80
+
+// Commands.
+#define REMOTE_CMD_PING     0x01
+#define REMOTE_CMD_GET      0x02
+#define REMOTE_CMD_SET      0x03
+#define REMOTE_CMD_STREAM   0x04
+
+// Profiler commands (only with ENABLE_PROFILER, see profiler.h). PROFILE request has the stage 
+// index or REMOTE_PROFILE_SUMMARY as the payload.
+#define REMOTE_CMD_PROFILE          0x05
+#define REMOTE_CMD_PROFILE_RESET    0x06
+
+#define REMOTE_PROFILE_SUMMARY      0xFF
+
+// Frames sent by the device without a request (see spectrumstream.h).
+#define REMOTE_FRAME_SPECTRUM   (REMOTE_RESPONSE | 0x40)
+
+// Setting fields of the GET response and the SET request. SET payload is a list of field and 
+// value pairs which are validated together and applied in a single update. GET response lists 
+// the values of all the fields in this order.
+#define REMOTE_FIELD_VOLUME     0x01
+#define REMOTE_FIELD_BASS       0x02
+#define REMOTE_FIELD_TREBLE     0x03
+#define REMOTE_FIELD_INPUT      0x04
+#define REMOTE_FIELD_STEREO     0x05
+#define REMOTE_FIELD_OUTPUT     0x06
+#define REMOTE_FIELD_MUTE       0x07
+
+#define REMOTE_FIELD_COUNT      7
+
+// Response status codes.
+#define REMOTE_STATUS_OK            0x00
+#define REMOTE_STATUS_UNKNOWN_CMD   0x01
+#define REMOTE_STATUS_BAD_LENGTH    0x02
+#define REMOTE_STATUS_BAD_VALUE     0x03
+
+#define REMOTE_PROTOCOL_VERSION     0x01
+
+// Command handler fills the response payload (after the status byte, up to REMOTE_MAX_REQUEST - 1 
+// bytes) and returns the status code. Handler is called from pollRemoteProtocol.
+typedef unsigned char (*RemoteCommandHandler)(unsigned char command, const unsigned char *payload, unsigned char length, 
+    unsigned char *response, unsigned char *responseLength);
+
+void initRemoteProtocol(RemoteCommandHandler handler);
+
+// Parse the received bytes and respond to the complete requests (called by a scheduler task).
+void pollRemoteProtocol();
+
+// Queue a frame for sending, returns FALSE if the frame does not fit into the UART buffer.
+unsigned char sendRemoteFrame(unsigned char command, unsigned char requestId, const unsigned char *payload, unsigned char length);
+
+#endif /* _ARDUINO_AMP_REMOTE_PROTO_HEADER_ */
@@ -0,0 +1,50 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_SCHEDULER_HEADER_
+#define _ARDUINO_AMP_SCHEDULER_HEADER_
+
+#define SCHEDULER_MAX_TASKS 10
+
+#define TASK_PERIODIC   0x00
+#define TASK_ONE_SHOT   0x01
+
+#define TASK_INVALID    0xFF
+
+typedef void (*TaskCallback)();
+
+unsigned char createTask(TaskCallback callback, unsigned short interval, unsigned char mode);
+
+void startTask(unsigned char taskId);
+void stopTask(unsigned char taskId);
+unsigned char isTaskActive(unsigned char taskId);
+
+// Run the tasks which are due, returns FALSE if no task was run.
+unsigned char runScheduler();
+
+// Sleep until the next interrupt (system tick, ADC, etc.), called when there is nothing to do.
+void idleScheduler();
+
+#endif /* _ARDUINO_AMP_SCHEDULER_HEADER_ */
@@ -0,0 +1,57 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_SPECTRUM_HEADER_
+#define _ARDUINO_AMP_SPECTRUM_HEADER_
+
+#include "common.h"
+
+// Number of points in the complex FFT, real samples are packed as (even, odd) pairs.
+#define SPECTRUM_FFT_POINTS (ANALYZER_SAMPLES / 2)
+
+#if SPECTRUM_FFT_POINTS == 128
+#define SPECTRUM_FFT_ORDER  7
+#elif SPECTRUM_FFT_POINTS == 64
+#define SPECTRUM_FFT_ORDER  6
+#else
+#error "Unsupported analyzer sample count"
+#endif
+
+// Upper limit of the bin magnitudes, adjacent bins can be summed without overflow.
+#define SPECTRUM_MAX_MAGNITUDE  0x7FFF
+
+// Display level mapping (in log2 Q4 units): the floor is at magnitude 128 (log2 = 7) and each 
+// level step is ~3dB, so 16 LCD levels cover a 48dB range.
+#define SPECTRUM_LEVEL_FLOOR    112
+#define SPECTRUM_LEVEL_STEP     8
+#define SPECTRUM_MAX_LEVEL      16
+
+void computeSpectrum(short *samples, unsigned short *magnitude);
+unsigned short estimateMagnitude(long real, long img);
+
+unsigned char getLog2Q4(unsigned short value);
+unsigned char magnitudeToLevel(unsigned short magnitude);
+
+#endif /* _ARDUINO_AMP_SPECTRUM_HEADER_ */
@@ -0,0 +1,55 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_SPECTRUM_STREAM_HEADER_
+#define _ARDUINO_AMP_SPECTRUM_STREAM_HEADER_
+
+#include "common.h"
+
+// Analyzer frames are sent as REMOTE_FRAME_SPECTRUM frames of the control protocol while the 
+// stream is enabled (by REMOTE_CMD_STREAM) and the analyzer is running. REQID field of the frame 
+// is the sequence number of the sent frames, payload is:
+//
+//   FLAGS | TIMESTAMP (16-bit, ms) | GAIN (log2 Q4, signed) | DROPPED | BANDS
+//
+// Keyframes (SPECTRUM_STREAM_KEYFRAME flag) carry the band magnitudes as 16-bit values, other 
+// frames carry the difference to the previous sent frame (modulo 2^16) as zigzag varints of 7 
+// bits per byte. DROPPED is the number of frames skipped before this frame because the UART 
+// transmit buffer was full. Multi-byte values are little-endian.
+#define SPECTRUM_STREAM_KEYFRAME    0x01
+
+// Keyframe is sent periodically (in frames), so a host can join a running stream.
+#define SPECTRUM_STREAM_KEYFRAME_INTERVAL   32
+
+#define SPECTRUM_STREAM_HEADER_SIZE     5
+
+void setSpectrumStream(unsigned char isEnabled);
+unsigned char isSpectrumStreamEnabled();
+
+// Send the band magnitudes of an analyzer frame, or drop the frame if it does not fit into the 
+// UART transmit buffer.
+void streamSpectrumFrame(const unsigned short *bands, short gain);
+
+#endif /* _ARDUINO_AMP_SPECTRUM_STREAM_HEADER_ */
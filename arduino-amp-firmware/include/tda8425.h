@@ -60,15 +60,19 @@
 #define SWITCH_LINE1_TWO_CHANNEL    0x03
 #define SWITCH_LINE2_TWO_CHANNEL    0x05
 
-void sendAudioProcCommand(unsigned char comAddr, unsigned char value);
+unsigned char sendAudioProcCommand(unsigned char comAddr, unsigned char value);
+
+// Retry the register writes which did not fit into the I2C queue (called from the main loop).
+void flushAudioProcRegisters();
 
 void initSoundProcessor(AudioSettings *audioSettings);
+void applyAudioSettings(AudioSettings *audioSettings);
+void applyAudioSettingsAtLevel(AudioSettings *audioSettings, unsigned char level);
 
-void setVolume(AudioSettings *audioSettings);
+void setVolumeLevel(unsigned char level);
 void setBass(AudioSettings *audioSettings);
 void setTreble(AudioSettings *audioSettings);
 
 void muteAudio(AudioSettings *audioSettings, unsigned char isMute);
-void setSwitchConfiguration(AudioSettings *audioSettings);
 
 #endif /* _ARDUINO_AMP_TDA8425_HEADER_ */
\ No newline at end of file
@@ -0,0 +1,66 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_UART_HEADER_
+#define _ARDUINO_AMP_UART_HEADER_
+
+#include "common.h"
+
+// Baud rate with no error at 16MHz clock, fast enough to stream the analyzer frames. A byte takes 
+// 320 cycles at 500000 baud and the USART holds ~3 bytes, so the RX ISR must run within ~960 
+// cycles. Goertzel ISR engine blocks the interrupts for longer (~1100 cycles per sample), so it 
+// uses 115200 baud (~4100 cycles).
+#if ANALYZER_ENGINE == ANALYZER_ENGINE_GOERTZEL_ISR
+#define UART_BAUD_RATE  115200UL
+#else
+#define UART_BAUD_RATE  500000UL
+#endif
+
+// Longest time (in CPU cycles) the other ISRs may block the RX interrupt without a receive overrun.
+#define UART_RX_MAX_LATENCY ((F_CPU * 3 * 10) / UART_BAUD_RATE)
+
+// Size of the receive and transmit ring buffers (must be a power of 2).
+#define UART_RX_BUFFER_SIZE 32
+#define UART_TX_BUFFER_SIZE 64
+
+// USART0 driver (8N1). Bytes are received and sent by the RX and UDRE interrupts in the 
+// background, none of the functions block. Serial object of the Arduino core must not be used 
+// with this driver, both of them own the USART0 interrupts.
+void initUART();
+
+// Get the next received byte, returns FALSE if the receive buffer is empty.
+unsigned char uartRead(unsigned char *data);
+
+// Queue the given bytes for sending. Bytes are queued only if all of them fit into the transmit 
+// buffer, otherwise nothing is queued and FALSE is returned.
+unsigned char uartWrite(const unsigned char *data, unsigned char length);
+
+// Free space in the transmit buffer (in bytes).
+unsigned char getUARTTxFree();
+
+// Number of received bytes dropped due to buffer overflow or framing errors.
+unsigned char getUARTRxErrors();
+
+#endif /* _ARDUINO_AMP_UART_HEADER_ */
@@ -0,0 +1,46 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_VOLUME_RAMP_HEADER_
+#define _ARDUINO_AMP_VOLUME_RAMP_HEADER_
+
+#include "common.h"
+
+// Volume registers of the TDA8425 are moved one step (2dB) per VOLUME_RAMP_INTERVAL towards the 
+// target by a scheduler task. Mute and switch changes ramp the volume down, apply the change 
+// while the output is silent and ramp back up. All functions only post the request.
+void initVolumeRamp(AudioSettings *audioSettings);
+
+void rampVolume(AudioSettings *audioSettings);
+void rampMute(AudioSettings *audioSettings, unsigned char isMute);
+void rampSwitchConfiguration(AudioSettings *audioSettings);
+
+// Apply the volume, tone and switch settings together. Tone is applied in the same TDA8425 update 
+// as the switch configuration, at the bottom of the ramp if the switch configuration is changed.
+void rampAudioSettings(AudioSettings *audioSettings, unsigned char isSwitchChanged);
+
+unsigned char isVolumeRampIdle();
+
+#endif /* _ARDUINO_AMP_VOLUME_RAMP_HEADER_ */
@@ -0,0 +1,54 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#ifndef _ARDUINO_AMP_WINDOW_HEADER_
+#define _ARDUINO_AMP_WINDOW_HEADER_
+
+#include "common.h"
+
+#include <avr/pgmspace.h>
+
+// Window functions for the analyzer capture.
+#define WINDOW_NONE     0x00
+#define WINDOW_HANN     0x01
+#define WINDOW_HAMMING  0x02
+#define WINDOW_BLACKMAN 0x03
+
+// Periodic windows are symmetric around the frame center, only the first half is stored.
+#define WINDOW_TABLE_SIZE   ((ANALYZER_SAMPLES / 2) + 1)
+
+#if ANALYZER_WINDOW != WINDOW_NONE
+
+extern const short windowTable[WINDOW_TABLE_SIZE] PROGMEM;
+
+// Window coefficient (Q15) for the given sample position of the frame.
+static inline short getWindowCoefficient(unsigned short samplePos)
+{
+    return (short)pgm_read_word(&windowTable[(samplePos <= (ANALYZER_SAMPLES / 2)) ? samplePos : (ANALYZER_SAMPLES - samplePos)]);
+}
+
+#endif
+
+#endif /* _ARDUINO_AMP_WINDOW_HEADER_ */
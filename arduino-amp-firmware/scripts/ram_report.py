@@ -0,0 +1,110 @@
+# SRAM usage report of the firmware (PlatformIO post-build script).
+#
+# Prints the .data and .bss size of each object file from the linker map (after unused sections
+# are removed by the linker), and fails the build if the free SRAM left for the stack is below
+# the custom_ram_min_free option of the environment.
+
+import os
+import re
+import subprocess
+
+Import("env")
+
+MAP_FILE = os.path.join(env.subst("$BUILD_DIR"), "firmware.map")
+RAM_SECTIONS = (".data", ".bss", ".noinit")
+
+env.Append(LINKFLAGS=["-Wl,-Map," + MAP_FILE])
+
+INPUT_SECTION = re.compile(r"^\s(\.[\w.$]+|COMMON)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S+)")
+
+
+def get_module_name(path):
+    build_dir = env.subst("$BUILD_DIR")
+    path = os.path.relpath(path, build_dir) if path.startswith(build_dir) else path
+
+    # Library objects are grouped by the library (archive) name.
+    archive = re.match(r"(.*\.a)\((.*)\)", path)
+    if archive:
+        return os.path.basename(archive.group(1))
+
+    return path.replace(".cpp.o", "").replace(".c.o", "").replace(".S.o", "")
+
+
+def parse_map_file():
+    modules = {}
+    output_section = None
+    pending_name = None
+
+    with open(MAP_FILE) as map_file:
+        lines = iter(map_file.read().splitlines())
+
+    # Skip to the memory map, the first part of the file lists the discarded sections.
+    for line in lines:
+        if line.startswith("Linker script and memory map"):
+            break
+
+    for line in lines:
+        if line and not line[0].isspace():
+            output_section = line.split()[0]
+            continue
+
+        if output_section not in RAM_SECTIONS:
+            continue
+
+        # Long input section names are printed on a separate line.
+        if pending_name is None and re.match(r"^\s\.[\w.$]+$", line):
+            pending_name = line.strip()
+            continue
+
+        match = INPUT_SECTION.match((" " + pending_name + line) if pending_name else line)
+        pending_name = None
+
+        if match and match.group(1) and not match.group(4).startswith("0x"):
+            size = int(match.group(3), 16)
+            if size > 0:
+                usage = modules.setdefault(get_module_name(match.group(4)), {".data": 0, ".bss": 0})
+                usage[".data" if output_section == ".data" else ".bss"] += size
+
+    return modules
+
+
+def get_elf_usage(elf_path):
+    output = subprocess.check_output([env.subst("$SIZETOOL"), "-A", elf_path]).decode()
+    usage = 0
+
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) >= 2 and fields[0] in RAM_SECTIONS:
+            usage += int(fields[1])
+
+    return usage
+
+
+def ram_report(source, target, env):
+    elf_path = target[0].get_abspath()
+    ram_size = int(env.BoardConfig().get("upload.maximum_ram_size", 2048))
+    min_free = int(env.GetProjectOption("custom_ram_min_free", 0))
+
+    modules = parse_map_file()
+
+    print("SRAM usage by module:")
+    print("  %-32s %6s %6s" % ("Module", ".data", ".bss"))
+
+    for name, usage in sorted(modules.items(), key=lambda item: -(item[1][".data"] + item[1][".bss"])):
+        print("  %-32s %6d %6d" % (name, usage[".data"], usage[".bss"]))
+
+    used = get_elf_usage(elf_path)
+    free = ram_size - used
+    print("SRAM: %d of %d bytes used, %d bytes free for stack (minimum %d)" % (used, ram_size, free, min_free))
+
+    if free < min_free:
+        print("Error: free SRAM is below custom_ram_min_free")
+
+        # Remove the firmware so the next build checks the budget again.
+        os.remove(elf_path)
+        return 1
+
+    return 0
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", ram_report)
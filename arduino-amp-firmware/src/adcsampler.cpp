@@ -0,0 +1,178 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "adcsampler.h"
+#include "common.h"
+#include "window.h"
+#include "q15math.h"
+#include "goertzel.h"
+#include "arena.h"
+
+#include <Arduino.h>
+#include <util/atomic.h>
+
+// Number of fractional bits used by the DC level tracker (time constant of 256 samples).
+#define DC_TRACK_SHIFT  8
+
+// DC-free 10-bit samples (+/-512) are scaled to Q15 with 2 bits headroom (+/-0.25 full scale). 
+// Magnitude scale of both engines, SPECTRUM_LEVEL_FLOOR and the Goertzel state range assume this 
+// input range.
+#define SAMPLE_Q15_SHIFT    4
+
+#if ANALYZER_ENGINE != ANALYZER_ENGINE_GOERTZEL_ISR
+// Ring of sample blocks filled by the ADC ISR. Each block is half of the analyzer frame, so the 
+// two latest complete blocks give a frame with 50% overlap to the previous one, while the ISR 
+// keeps filling the third block.
+#define SAMPLE_BLOCKS       3
+#define SAMPLE_BLOCK_SIZE   (ANALYZER_SAMPLES / 2)
+
+static short sampleRing[SAMPLE_BLOCKS][SAMPLE_BLOCK_SIZE];
+
+static_assert((sizeof(sampleRing) + sizeof(AnalyzerScratch)) <= ANALYZER_RAM_BUDGET, "Analyzer buffers exceed ANALYZER_RAM_BUDGET");
+
+static volatile unsigned char fillBlock, blockCount;
+static unsigned char lastBlockCount;
+#endif
+
+static volatile unsigned short samplePos;
+static unsigned long dcLevel;
+
+void initAudioSampler(unsigned char prescaler)
+{
+#if ANALYZER_ENGINE != ANALYZER_ENGINE_GOERTZEL_ISR
+    fillBlock = 0;
+    blockCount = 0;
+    lastBlockCount = 0;
+#endif
+    samplePos = 0;
+
+    // Start with the DC level at the middle of the ADC range.
+    dcLevel = 512UL << DC_TRACK_SHIFT;
+
+    // Disable digital input buffer of the analog input pin (ADC0).
+    DIDR0 |= _BV(ADC0D);
+
+    // AVcc reference and select channel 0. With 8-bit resolution the result is left adjusted, 
+    // so only the ADCH register is read.
+#if ANALYZER_ADC_RESOLUTION == 8
+    ADMUX = _BV(REFS0) | _BV(ADLAR);
+#else
+    ADMUX = _BV(REFS0);
+#endif
+
+    // Free-running trigger source.
+    ADCSRB = 0x00;
+
+    // Enable ADC in auto trigger mode with conversion complete interrupt and start the first conversion.
+    ADCSRA = _BV(ADEN) | _BV(ADSC) | _BV(ADATE) | _BV(ADIE) | (prescaler & 0x07);
+}
+
+#if ANALYZER_ENGINE != ANALYZER_ENGINE_GOERTZEL_ISR
+unsigned char getSampleFrame(short *frame)
+{
+    unsigned char count, block, newestBlock, oldestBlock;
+    unsigned short framePos;
+    short sample;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        count = blockCount;
+        newestBlock = (fillBlock + SAMPLE_BLOCKS - 1) % SAMPLE_BLOCKS;
+    }
+
+    if(count == lastBlockCount)
+    {
+        // No new sample block since the last frame.
+        return FALSE;
+    }
+
+    oldestBlock = (newestBlock + SAMPLE_BLOCKS - 1) % SAMPLE_BLOCKS;
+
+    for(framePos = 0; framePos < ANALYZER_SAMPLES; framePos++)
+    {
+        block = (framePos < SAMPLE_BLOCK_SIZE) ? oldestBlock : newestBlock;
+        sample = sampleRing[block][framePos % SAMPLE_BLOCK_SIZE];
+
+#if ANALYZER_WINDOW != WINDOW_NONE
+        // Window is applied on the copy, since each sample is used in two overlapped frames.
+        sample = mulQ15(sample, getWindowCoefficient(framePos));
+#endif
+
+        // Even samples are stored in the first half and odd samples in the second half of the 
+        // frame (real and imaginary inputs of the packed real FFT).
+        frame[(framePos >> 1) + ((framePos & 0x01) ? (ANALYZER_SAMPLES / 2) : 0)] = sample;
+    }
+
+    if(blockCount != count)
+    {
+        // ADC ISR moved into the oldest block while copying, so the frame may be corrupted. 
+        // Try again with the next block.
+        return FALSE;
+    }
+
+    lastBlockCount = count;
+    return TRUE;
+}
+#endif
+
+ISR(ADC_vect)
+{
+#if ANALYZER_ADC_RESOLUTION == 8
+    int sample = ADCH << 2;
+#else
+    int sample = ADC;
+#endif
+
+    // Track the DC level of the input and remove it from the sample.
+    dcLevel = dcLevel + sample - (dcLevel >> DC_TRACK_SHIFT);
+    sample = sample - (int)(dcLevel >> DC_TRACK_SHIFT);
+
+    sample = sample << SAMPLE_Q15_SHIFT;
+
+#if ANALYZER_ENGINE == ANALYZER_ENGINE_GOERTZEL_ISR
+#if ANALYZER_WINDOW != WINDOW_NONE
+    sample = mulQ15(sample, getWindowCoefficient(samplePos));
+#endif
+
+    // Run the Goertzel filters on each sample, filter states are latched at the end of the frame.
+    updateGoertzel(sample);
+
+    if(++samplePos >= ANALYZER_SAMPLES)
+    {
+        samplePos = 0;
+        latchGoertzel();
+    }
+#else
+    sampleRing[fillBlock][samplePos] = sample;
+
+    if(++samplePos >= SAMPLE_BLOCK_SIZE)
+    {
+        // Block is complete, continue on the next block of the ring.
+        samplePos = 0;
+        fillBlock = (fillBlock + 1) % SAMPLE_BLOCKS;
+        blockCount++;
+    }
+#endif
+}
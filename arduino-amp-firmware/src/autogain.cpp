@@ -0,0 +1,123 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "autogain.h"
+#include "common.h"
+#include "spectrum.h"
+#include "bargraph.h"
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+// Level tracker keeps 4 more fractional bits than the log2 Q4 input.
+#define AGC_FRAC_BITS   4
+
+// Log2 Q4 level which is shown ANALYZER_AGC_HEADROOM levels below the top of the bar graph.
+#define AGC_TARGET_LEVEL    (SPECTRUM_LEVEL_FLOOR + ((BAR_GRAPH_MAX_HEIGHT - ANALYZER_AGC_HEADROOM) * SPECTRUM_LEVEL_STEP))
+
+// Gain mantissa 2^(i/16) in Q7 format, for the fractional part of the gain.
+static const unsigned char gainMantissaTable[16] PROGMEM = 
+{
+    128, 134, 140, 146, 152, 159, 166, 173, 181, 189, 197, 206, 215, 225, 235, 245
+};
+
+static short agcLevel;
+static short agcGain;
+
+void resetAutoGain()
+{
+    // Start with unity gain.
+    agcLevel = AGC_TARGET_LEVEL << AGC_FRAC_BITS;
+    agcGain = 0;
+}
+
+short getAutoGain()
+{
+    return agcGain;
+}
+
+static void updateGain(unsigned short peak)
+{
+    short level = (short)getLog2Q4(peak) << AGC_FRAC_BITS;
+    short gain;
+
+    // Follow rising levels quickly and release slowly, so the display scale stays stable.
+    if(level > agcLevel)
+    {
+        agcLevel += ((level - agcLevel) >> ANALYZER_AGC_ATTACK_SHIFT) + 1;
+    }
+    else if(level < agcLevel)
+    {
+        agcLevel -= ((agcLevel - level) >> ANALYZER_AGC_RELEASE_SHIFT) + 1;
+    }
+
+    gain = AGC_TARGET_LEVEL - (agcLevel >> AGC_FRAC_BITS);
+
+    if(gain > ANALYZER_AGC_MAX_GAIN)
+    {
+        gain = ANALYZER_AGC_MAX_GAIN;
+    }
+    else if(gain < ANALYZER_AGC_MIN_GAIN)
+    {
+        gain = ANALYZER_AGC_MIN_GAIN;
+    }
+
+    agcGain = gain;
+}
+
+void applyAutoGain(unsigned short *bands)
+{
+    unsigned char band, shift, mantissa;
+    unsigned short peak = 0;
+    unsigned short value;
+
+    for(band = 0; band < ANALYZER_COLUMNS; band++)
+    {
+        peak = (bands[band] > peak) ? bands[band] : peak;
+    }
+
+    updateGain(peak);
+
+    // Gain is applied as 2^(fraction/16) multiplication followed by the shift of the integer 
+    // part: left shift with saturation for boost, right shift for cut.
+    mantissa = pgm_read_byte(&gainMantissaTable[agcGain & 0x0F]);
+    shift = (unsigned char)((agcGain >= 0) ? (agcGain >> 4) : ((-agcGain + 15) >> 4));
+
+    for(band = 0; band < ANALYZER_COLUMNS; band++)
+    {
+        value = ((unsigned long)bands[band] * mantissa) >> 7;
+
+        if(agcGain >= 0)
+        {
+            value = (value > (SPECTRUM_MAX_MAGNITUDE >> shift)) ? SPECTRUM_MAX_MAGNITUDE : (value << shift);
+        }
+        else
+        {
+            value = value >> shift;
+        }
+
+        bands[band] = value;
+    }
+}
@@ -0,0 +1,115 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "bands.h"
+#include "common.h"
+#include "constmath.h"
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+static_assert(ANALYZER_COLUMNS <= BAND_MAX_COLUMNS, "Too many analyzer columns");
+
+// Bin range table is generated at compile time. Band edges are spaced logarithmically between 
+// the lowest and the highest frequency, and each band has at least one FFT bin.
+
+constexpr unsigned char bandFreqToBin(unsigned long freq)
+{
+    return (unsigned char)((freq * ANALYZER_SAMPLES) / ANALYZER_SAMPLE_RATE);
+}
+
+// First bin of the lowest band (DC bin is skipped) and the end of the highest band.
+constexpr unsigned char BAND_FIRST_BIN = constMaxU8(1, bandFreqToBin(ANALYZER_BAND_MIN_FREQ));
+constexpr unsigned char BAND_END_BIN = constMinU8(ANALYZER_BINS, bandFreqToBin(ANALYZER_BAND_MAX_FREQ) + 1);
+
+constexpr double BAND_RATIO = constRoot((double)BAND_END_BIN / BAND_FIRST_BIN, ANALYZER_COLUMNS, 1.5, 32);
+
+constexpr unsigned char bandEdge(unsigned char band)
+{
+    return (band == 0) ? BAND_FIRST_BIN : 
+        ((band >= ANALYZER_COLUMNS) ? BAND_END_BIN :
+        constMaxU8(bandEdge(band - 1) + 1, (unsigned char)((BAND_FIRST_BIN * constPower(BAND_RATIO, band)) + 0.5)));
+}
+
+static_assert(bandEdge(ANALYZER_COLUMNS - 1) < BAND_END_BIN, "Not enough FFT bins for the analyzer columns");
+
+// Start bin of each band, the last entry is the end of the highest band.
+static const unsigned char bandEdgeTable[BAND_MAX_COLUMNS + 1] PROGMEM = 
+{
+    bandEdge(0), bandEdge(1), bandEdge(2), bandEdge(3), bandEdge(4), bandEdge(5), bandEdge(6), bandEdge(7), 
+    bandEdge(8), bandEdge(9), bandEdge(10), bandEdge(11), bandEdge(12), bandEdge(13), bandEdge(14), bandEdge(15),
+    bandEdge(16)
+};
+
+// Averaged band magnitudes, scaled by 2^ANALYZER_AVERAGE_SHIFT.
+static unsigned long bandAverage[ANALYZER_COLUMNS];
+
+void aggregateBands(const unsigned short *magnitude, unsigned short *bands)
+{
+    unsigned char band, binPos, endBin;
+    unsigned short value;
+
+    binPos = pgm_read_byte(&bandEdgeTable[0]);
+
+    // Single linear pass over the bins.
+    for(band = 0; band < ANALYZER_COLUMNS; band++)
+    {
+        endBin = pgm_read_byte(&bandEdgeTable[band + 1]);
+        value = 0;
+
+        for(; binPos < endBin; binPos++)
+        {
+#if ANALYZER_BAND_MODE == BAND_MODE_SUM
+            // Saturated sum of the bin magnitudes.
+            value = ((0xFFFF - value) < magnitude[binPos]) ? 0xFFFF : (value + magnitude[binPos]);
+#else
+            value = (magnitude[binPos] > value) ? magnitude[binPos] : value;
+#endif
+        }
+
+        bands[band] = value;
+    }
+}
+
+void averageBands(const unsigned short *bands)
+{
+    unsigned char band;
+
+    // Average is kept with ANALYZER_AVERAGE_SHIFT fractional bits: avg += new - avg / 2^shift.
+    for(band = 0; band < ANALYZER_COLUMNS; band++)
+    {
+        bandAverage[band] = bandAverage[band] - (bandAverage[band] >> ANALYZER_AVERAGE_SHIFT) + bands[band];
+    }
+}
+
+void getAverageBands(unsigned short *bands)
+{
+    unsigned char band;
+
+    for(band = 0; band < ANALYZER_COLUMNS; band++)
+    {
+        bands[band] = bandAverage[band] >> ANALYZER_AVERAGE_SHIFT;
+    }
+}
@@ -0,0 +1,169 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "bargraph.h"
+#include "common.h"
+#include "lcdframe.h"
+#include "lcddriver.h"
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+extern LCDFrameBuffer frameBuffer;
+
+// Bar and peak positions are kept with 4 fractional bits, so slow decay rates are possible.
+#define BAR_FRAC_BITS   4
+#define BAR_CELL_HEIGHT 8
+
+// Number of render frames the peak marker is held at its position.
+#define BAR_PEAK_HOLD_FRAMES    (ANALYZER_PEAK_HOLD / ANALYZER_RENDER_INTERVAL)
+
+// Cells filled from the bottom (1 to 7 pixel rows).
+static const unsigned char barGlyphs[BAR_CELL_HEIGHT - 1][8] PROGMEM = 
+{
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F},
+    {0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F},
+    {0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F},
+    {0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F},
+    {0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F}
+};
+
+// Peak-hold marker, a line on top of the cell.
+static const unsigned char peakGlyph[8] PROGMEM = {0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+static unsigned short barHeight[ANALYZER_COLUMNS];
+static unsigned short peakHeight[ANALYZER_COLUMNS];
+static unsigned char peakHoldTime[ANALYZER_COLUMNS];
+
+void initBarGraph()
+{
+    unsigned char glyph;
+
+    // Define custom characters required for the spectrum analyzer.
+    for(glyph = 0; glyph < (BAR_CELL_HEIGHT - 1); glyph++)
+    {
+        lcdCreateChar(glyph + 1, barGlyphs[glyph]);
+    }
+
+    lcdCreateChar(BAR_GRAPH_PEAK_GLYPH, peakGlyph);
+
+    resetBarGraph();
+}
+
+void resetBarGraph()
+{
+    unsigned char column;
+
+    for(column = 0; column < ANALYZER_COLUMNS; column++)
+    {
+        barHeight[column] = 0;
+        peakHeight[column] = 0;
+        peakHoldTime[column] = 0;
+    }
+}
+
+void updateBarGraph(const unsigned short *levels)
+{
+    unsigned char column;
+    unsigned short target, step;
+
+    for(column = 0; column < ANALYZER_COLUMNS; column++)
+    {
+        target = ((levels[column] < BAR_GRAPH_MAX_HEIGHT) ? levels[column] : BAR_GRAPH_MAX_HEIGHT) << BAR_FRAC_BITS;
+
+        // Bars move by a fraction of the distance to the new level, with fast attack and slow decay.
+        if(target > barHeight[column])
+        {
+            step = (target - barHeight[column]) >> ANALYZER_ATTACK_SHIFT;
+            barHeight[column] += (step > 0) ? step : 1;
+        }
+        else if(target < barHeight[column])
+        {
+            step = (barHeight[column] - target) >> ANALYZER_DECAY_SHIFT;
+            barHeight[column] -= (step > 0) ? step : 1;
+        }
+
+        // Peak marker follows the bar up, holds for a while and then falls at a constant rate.
+        if(barHeight[column] >= peakHeight[column])
+        {
+            peakHeight[column] = barHeight[column];
+            peakHoldTime[column] = BAR_PEAK_HOLD_FRAMES;
+        }
+        else if(peakHoldTime[column] > 0)
+        {
+            peakHoldTime[column]--;
+        }
+        else
+        {
+            peakHeight[column] = (peakHeight[column] > (barHeight[column] + ANALYZER_PEAK_DECAY)) ? 
+                (peakHeight[column] - ANALYZER_PEAK_DECAY) : barHeight[column];
+        }
+    }
+}
+
+static unsigned char getCellGlyph(unsigned char bar, unsigned char peak, unsigned char cellBase)
+{
+    // Bar level inside this cell.
+    if(bar >= (cellBase + BAR_CELL_HEIGHT))
+    {
+        return BAR_GRAPH_FULL_GLYPH;
+    }
+
+    if(bar > cellBase)
+    {
+        return bar - cellBase;
+    }
+
+    // Empty cell, show the peak marker if the peak level is inside this cell.
+    if((peak > bar) && (peak > cellBase) && (peak <= (cellBase + BAR_CELL_HEIGHT)))
+    {
+        return BAR_GRAPH_PEAK_GLYPH;
+    }
+
+    return ' ';
+}
+
+void drawBarGraph()
+{
+    unsigned char column, row;
+    unsigned char bar, peak;
+
+    // Every cell is written, so only the cells with a different glyph are sent to the LCD 
+    // on the next flush.
+    for(row = 0; row < LCD_ROWS; row++)
+    {
+        frameBuffer.setCursor(0, row);
+
+        for(column = 0; column < ANALYZER_COLUMNS; column++)
+        {
+            bar = barHeight[column] >> BAR_FRAC_BITS;
+            peak = peakHeight[column] >> BAR_FRAC_BITS;
+
+            frameBuffer.write(getCellGlyph(bar, peak, (LCD_ROWS - 1 - row) * BAR_CELL_HEIGHT));
+        }
+    }
+}
@@ -0,0 +1,198 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+// Cycle count comparison of the Q15 FFT engine and the 8-bit fix_fft library, and the per-frame 
+// cost of the FFT and Goertzel analyzer engines. This is a 
+// standalone firmware, build and upload with "pio run -e fftbench -t upload" and check the 
+// results on the serial monitor (115200 baud).
+
+#include "fftq15.h"
+#include "spectrum.h"
+#include "bands.h"
+#include "goertzel.h"
+
+#include <Arduino.h>
+#include <fix_fft.h>
+
+#define BENCH_MAX_POINTS    128
+#define BENCH_RUNS          8
+
+// Timer1 runs with clk/8 prescaler, so each tick is 8 CPU cycles (32ms range).
+#define BENCH_CYCLES_PER_TICK   8
+
+static short q15Real[BENCH_MAX_POINTS], q15Img[BENCH_MAX_POINTS];
+static char fixReal[BENCH_MAX_POINTS], fixImg[BENCH_MAX_POINTS];
+
+static short frameData[ANALYZER_SAMPLES];
+static unsigned short binData[ANALYZER_BINS], bandData[ANALYZER_COLUMNS];
+
+static void loadTestSignal(unsigned char points)
+{
+    unsigned char pos;
+    short value;
+
+    // Two tones with some noise, scaled to the input range of each engine.
+    for(pos = 0; pos < points; pos++)
+    {
+        value = ((pos & 0x08) ? 8000 : -8000) + ((pos & 0x01) ? 4000 : -4000) + (random(-1000, 1000));
+
+        q15Real[pos] = value;
+        q15Img[pos] = 0;
+        fixReal[pos] = (char)(value >> 8);
+        fixImg[pos] = 0;
+    }
+}
+
+static unsigned long measureQ15(unsigned char order)
+{
+    unsigned short ticks;
+
+    loadTestSignal(1 << order);
+
+    noInterrupts();
+    TCNT1 = 0;
+    fftQ15(q15Real, q15Img, order);
+    ticks = TCNT1;
+    interrupts();
+
+    return (unsigned long)ticks * BENCH_CYCLES_PER_TICK;
+}
+
+static unsigned long measureFixFFT(unsigned char order)
+{
+    unsigned short ticks;
+
+    loadTestSignal(1 << order);
+
+    noInterrupts();
+    TCNT1 = 0;
+    fix_fft(fixReal, fixImg, order, 0);
+    ticks = TCNT1;
+    interrupts();
+
+    return (unsigned long)ticks * BENCH_CYCLES_PER_TICK;
+}
+
+static void runBenchmark(unsigned char order)
+{
+    unsigned char run;
+    unsigned long q15Cycles = 0, fixCycles = 0;
+
+    for(run = 0; run < BENCH_RUNS; run++)
+    {
+        q15Cycles += measureQ15(order);
+        fixCycles += measureFixFFT(order);
+    }
+
+    Serial.print(1 << order);
+    Serial.print(F(" points: fftQ15 (16-bit) "));
+    Serial.print(q15Cycles / BENCH_RUNS);
+    Serial.print(F(" cycles, fix_fft (8-bit) "));
+    Serial.print(fixCycles / BENCH_RUNS);
+    Serial.println(F(" cycles"));
+}
+
+static void loadTestFrame()
+{
+    unsigned short pos;
+
+    for(pos = 0; pos < ANALYZER_SAMPLES; pos++)
+    {
+        frameData[pos] = ((pos & 0x08) ? 8000 : -8000) + ((pos & 0x01) ? 4000 : -4000) + (random(-1000, 1000));
+    }
+}
+
+static void printEngineResult(const __FlashStringHelper *name, unsigned short ticks)
+{
+    Serial.print(name);
+    Serial.print((unsigned long)ticks * BENCH_CYCLES_PER_TICK);
+    Serial.print(F(" cycles ("));
+    Serial.print(((unsigned long)ticks * BENCH_CYCLES_PER_TICK) / (F_CPU / 1000000UL));
+    Serial.println(F("us)"));
+}
+
+static void runEngineBenchmark()
+{
+    unsigned short pos, ticks;
+
+    Serial.print(ANALYZER_SAMPLES);
+    Serial.println(F(" samples per frame, band magnitudes of one frame:"));
+
+    loadTestFrame();
+    noInterrupts();
+    TCNT1 = 0;
+    computeSpectrum(frameData, binData);
+    aggregateBands(binData, bandData);
+    ticks = TCNT1;
+    interrupts();
+    printEngineResult(F("  FFT engine: "), ticks);
+
+    loadTestFrame();
+    noInterrupts();
+    TCNT1 = 0;
+    computeGoertzel(frameData, bandData);
+    ticks = TCNT1;
+    interrupts();
+    printEngineResult(F("  Goertzel engine: "), ticks);
+
+    // Per-sample engine cost is spread over the ADC ISR, the band magnitudes are computed in 
+    // the analyzer task.
+    loadTestFrame();
+    noInterrupts();
+    TCNT1 = 0;
+    for(pos = 0; pos < ANALYZER_SAMPLES; pos++)
+    {
+        updateGoertzel(frameData[pos]);
+    }
+    latchGoertzel();
+    ticks = TCNT1;
+    interrupts();
+    printEngineResult(F("  Goertzel ISR engine (in ISR): "), ticks);
+
+    noInterrupts();
+    TCNT1 = 0;
+    getGoertzelBands(bandData);
+    ticks = TCNT1;
+    interrupts();
+    printEngineResult(F("  Goertzel ISR engine (in task): "), ticks);
+}
+
+void setup()
+{
+    Serial.begin(115200);
+
+    // Timer1 in normal mode with clk/8 prescaler.
+    TCCR1A = 0;
+    TCCR1B = _BV(CS11);
+
+    Serial.println(F("FFT benchmark"));
+    runBenchmark(6);
+    runBenchmark(7);
+    runEngineBenchmark();
+}
+
+void loop()
+{
+}
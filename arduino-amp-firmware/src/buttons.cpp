@@ -0,0 +1,198 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "buttons.h"
+#include "common.h"
+#include "fastpin.h"
+
+#include <Arduino.h>
+
+// All the buttons are connected to PORTB (PCINT0 group), and are active low.
+static_assert((FastPin<SWITCH_ACTION>::portId == FASTPIN_PORT_B) && (FastPin<SWITCH_UP>::portId == FASTPIN_PORT_B) && 
+    (FastPin<SWITCH_DOWN>::portId == FASTPIN_PORT_B) && (FastPin<SWITCH_MUTE>::portId == FASTPIN_PORT_B), "Buttons must be on PORTB");
+
+#define BUTTON_PIN_MASK(pin)    FastPin<pin>::mask
+
+static const unsigned char buttonMask[BUTTON_COUNT] = 
+{
+    BUTTON_PIN_MASK(SWITCH_ACTION), 
+    BUTTON_PIN_MASK(SWITCH_UP), 
+    BUTTON_PIN_MASK(SWITCH_DOWN), 
+    BUTTON_PIN_MASK(SWITCH_MUTE)
+};
+
+#define BUTTON_ALL_MASK (BUTTON_PIN_MASK(SWITCH_ACTION) | BUTTON_PIN_MASK(SWITCH_UP) | BUTTON_PIN_MASK(SWITCH_DOWN) | BUTTON_PIN_MASK(SWITCH_MUTE))
+
+// Event ring buffer: written only by the system tick ISR and read only by the main loop.
+static volatile unsigned char eventQueue[BUTTON_QUEUE_SIZE];
+static volatile unsigned char queueHead, queueTail;
+
+static volatile unsigned short systemTick;
+
+// Raw pin state captured on the last pin change and the buttons with unsettled edges.
+static volatile unsigned char rawState, pendingEdges;
+static volatile unsigned short edgeTime[BUTTON_COUNT];
+
+// Debounced button state, long press and auto-repeat tracking (used only inside the system tick ISR).
+static unsigned char stableState, longPressDone;
+static unsigned short pressTime[BUTTON_COUNT];
+static unsigned short repeatTime[BUTTON_COUNT];
+static unsigned char repeatInterval[BUTTON_COUNT];
+
+void initButtons()
+{
+    queueHead = 0;
+    queueTail = 0;
+    systemTick = 0;
+    pendingEdges = 0;
+    longPressDone = 0;
+
+    FastPin<SWITCH_ACTION>::setInputPullup();
+    FastPin<SWITCH_UP>::setInputPullup();
+    FastPin<SWITCH_DOWN>::setInputPullup();
+    FastPin<SWITCH_MUTE>::setInputPullup();
+
+    rawState = PINB & BUTTON_ALL_MASK;
+    stableState = rawState;
+
+    // Enable pin change interrupts for all the buttons.
+    PCMSK0 |= BUTTON_ALL_MASK;
+    PCIFR = _BV(PCIF0);
+    PCICR |= _BV(PCIE0);
+
+    // Timer0 is already running for millis(), use its compare match A as ~1ms system tick.
+    OCR0A = 0x80;
+    TIMSK0 |= _BV(OCIE0A);
+}
+
+unsigned char getButtonEvent()
+{
+    unsigned char event;
+
+    if(queueTail == queueHead)
+    {
+        // Event queue is empty.
+        return BUTTON_EVENT_NONE;
+    }
+
+    event = eventQueue[queueTail];
+    queueTail = (queueTail + 1) & (BUTTON_QUEUE_SIZE - 1);
+
+    return event;
+}
+
+static void pushButtonEvent(unsigned char event)
+{
+    unsigned char nextHead = (queueHead + 1) & (BUTTON_QUEUE_SIZE - 1);
+
+    // Drop the event if the queue is full.
+    if(nextHead != queueTail)
+    {
+        eventQueue[queueHead] = event;
+        queueHead = nextHead;
+    }
+}
+
+ISR(PCINT0_vect)
+{
+    unsigned char pinState = PINB & BUTTON_ALL_MASK;
+    unsigned char changed = pinState ^ rawState;
+    unsigned char buttonId;
+
+    // Timestamp the edges, debounce is done in the system tick.
+    for(buttonId = 0; buttonId < BUTTON_COUNT; buttonId++)
+    {
+        if(changed & buttonMask[buttonId])
+        {
+            edgeTime[buttonId] = systemTick;
+        }
+    }
+
+    rawState = pinState;
+    pendingEdges |= changed;
+}
+
+ISR(TIMER0_COMPA_vect)
+{
+    unsigned char buttonId, mask;
+    unsigned short tick = ++systemTick;
+
+    if((pendingEdges == 0) && (stableState == BUTTON_ALL_MASK))
+    {
+        // No button activities.
+        return;
+    }
+
+    for(buttonId = 0; buttonId < BUTTON_COUNT; buttonId++)
+    {
+        mask = buttonMask[buttonId];
+
+        // Accept the new state once the pin is stable for the debounce time.
+        if((pendingEdges & mask) && ((unsigned short)(tick - edgeTime[buttonId]) >= BUTTON_DEBOUNCE_TIME))
+        {
+            pendingEdges &= ~mask;
+
+            if((rawState ^ stableState) & mask)
+            {
+                stableState ^= mask;
+
+                if(stableState & mask)
+                {
+                    pushButtonEvent(buttonId | BUTTON_EVENT_RELEASE);
+                }
+                else
+                {
+                    pressTime[buttonId] = tick;
+                    longPressDone &= ~mask;
+
+                    repeatTime[buttonId] = tick + BUTTON_REPEAT_DELAY;
+                    repeatInterval[buttonId] = BUTTON_REPEAT_INTERVAL;
+                    pushButtonEvent(buttonId | BUTTON_EVENT_PRESS);
+                }
+            }
+        }
+
+        // Check for long press on the buttons which are held down.
+        if(((stableState & mask) == 0) && ((longPressDone & mask) == 0) && ((unsigned short)(tick - pressTime[buttonId]) >= BUTTON_LONG_PRESS_TIME))
+        {
+            longPressDone |= mask;
+            pushButtonEvent(buttonId | BUTTON_EVENT_LONG_PRESS);
+        }
+
+        // Auto-repeat with acceleration while the button is held down.
+        if(((stableState & mask) == 0) && (BUTTON_REPEAT_MASK & _BV(buttonId)) && ((short)(tick - repeatTime[buttonId]) >= 0))
+        {
+            pushButtonEvent(buttonId | BUTTON_EVENT_REPEAT);
+
+            repeatInterval[buttonId] -= repeatInterval[buttonId] >> BUTTON_REPEAT_ACCEL_SHIFT;
+            if(repeatInterval[buttonId] < BUTTON_REPEAT_MIN_INTERVAL)
+            {
+                repeatInterval[buttonId] = BUTTON_REPEAT_MIN_INTERVAL;
+            }
+
+            repeatTime[buttonId] = tick + repeatInterval[buttonId];
+        }
+    }
+}
@@ -0,0 +1,175 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "configstore.h"
+#include "common.h"
+#include "eepromqueue.h"
+
+#include <Arduino.h>
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+#include <string.h>
+#include <stddef.h>
+
+static_assert(sizeof(ConfigRecord) == CONFIG_RECORD_SIZE, "Invalid configuration record size");
+static_assert(CONFIG_STORE_SLOTS <= 128, "Sequence number range is too small for the number of slots");
+static_assert(CONFIG_RECORD_WRITES < EEPROM_QUEUE_SIZE, "EEPROM write queue is too small for a record");
+
+// Slot of the newest valid record and a copy of it.
+static unsigned char newestSlot;
+static ConfigRecord newestRecord;
+
+// Settings of the last save which did not fit into the EEPROM write queue yet.
+static AudioSettings pendingSettings;
+static unsigned char pendingOutputMode;
+static unsigned char isWritePending;
+
+static unsigned char getRecordCRC(const ConfigRecord *record)
+{
+    const unsigned char *data = (const unsigned char *)record;
+    unsigned char pos, crc = 0;
+
+    // CRC covers all fields except the CRC itself.
+    for(pos = 0; pos < (CONFIG_RECORD_SIZE - 1); pos++)
+    {
+        crc = _crc8_ccitt_update(crc, data[pos]);
+    }
+
+    return crc;
+}
+
+static void readRecord(unsigned char slot, ConfigRecord *record)
+{
+    unsigned char *data = (unsigned char *)record;
+    unsigned char pos;
+
+    for(pos = 0; pos < CONFIG_RECORD_SIZE; pos++)
+    {
+        data[pos] = eeprom_read_byte((const uint8_t *)(uintptr_t)((slot * CONFIG_RECORD_SIZE) + pos));
+    }
+}
+
+void initConfigStore()
+{
+    unsigned char slot;
+    ConfigRecord record;
+
+    newestSlot = CONFIG_SLOT_NONE;
+    isWritePending = FALSE;
+
+    for(slot = 0; slot < CONFIG_STORE_SLOTS; slot++)
+    {
+        readRecord(slot, &record);
+
+        // Erased, torn or foreign records fail the version or the CRC check.
+        if((record.version != CONFIG_RECORD_VERSION) || (record.crc != getRecordCRC(&record)))
+        {
+            continue;
+        }
+
+        // All records in the store are less than 128 writes apart, so the sequence numbers 
+        // are compared with the wrap around.
+        if((newestSlot == CONFIG_SLOT_NONE) || ((signed char)(record.sequence - newestRecord.sequence) > 0))
+        {
+            newestSlot = slot;
+            newestRecord = record;
+        }
+    }
+}
+
+unsigned char readConfigRecord(AudioSettings *settings, unsigned char *outputMode)
+{
+    if(newestSlot == CONFIG_SLOT_NONE)
+    {
+        return FALSE;
+    }
+
+    *settings = newestRecord.settings;
+    *outputMode = newestRecord.outputMode;
+    return TRUE;
+}
+
+static void commitConfigRecord()
+{
+    unsigned char slot, pos;
+    unsigned short address;
+    unsigned char *data;
+
+    if((newestSlot != CONFIG_SLOT_NONE) && (newestRecord.outputMode == pendingOutputMode) && 
+        (memcmp(&newestRecord.settings, &pendingSettings, sizeof(AudioSettings)) == 0))
+    {
+        // Nothing changed since the last save.
+        isWritePending = FALSE;
+        return;
+    }
+
+    if(getEEPROMQueueFree() < CONFIG_RECORD_WRITES)
+    {
+        // Record is queued as a whole or not at all, retry once the previous writes are done.
+        return;
+    }
+
+    slot = (newestSlot == CONFIG_SLOT_NONE) ? 0 : ((newestSlot + 1) % CONFIG_STORE_SLOTS);
+
+    newestRecord.sequence++;
+    newestRecord.settings = pendingSettings;
+    newestRecord.outputMode = pendingOutputMode;
+    newestRecord.version = CONFIG_RECORD_VERSION;
+    newestRecord.crc = getRecordCRC(&newestRecord);
+
+    // Bytes are written in order by the EEPROM write queue. The version byte is invalidated 
+    // first and written back after the data, so a write interrupted before that point always 
+    // fails the version check (CRC alone would pass a mixed record with ~1/256 probability). If 
+    // only the CRC is missing, all the data is already the new record.
+    address = slot * CONFIG_RECORD_SIZE;
+    eepromWrite(address + offsetof(ConfigRecord, version), CONFIG_RECORD_INVALID);
+
+    data = (unsigned char *)&newestRecord;
+    for(pos = 0; pos < CONFIG_RECORD_SIZE; pos++)
+    {
+        eepromWrite(address + pos, data[pos]);
+    }
+
+    newestSlot = slot;
+    isWritePending = FALSE;
+}
+
+void writeConfigRecord(const AudioSettings *settings, unsigned char outputMode)
+{
+    // Newer settings replace a pending record which did not fit into the queue.
+    pendingSettings = *settings;
+    pendingOutputMode = outputMode;
+    isWritePending = TRUE;
+
+    commitConfigRecord();
+}
+
+void flushConfigStore()
+{
+    if(isWritePending)
+    {
+        commitConfigRecord();
+    }
+}
@@ -26,105 +26,175 @@
 #include "common.h"
 #include "displayutil.h"
 #include "tda8425.h"
+#include "lcdframe.h"
 
-#include <LiquidCrystal.h>
+#include <avr/pgmspace.h>
 
-extern LiquidCrystal lcd;
+extern LCDFrameBuffer frameBuffer;
+
+// UI strings are kept in the program memory and printed directly from there.
+static const char labelInput[] PROGMEM = "Input: ";
+static const char labelBass[] PROGMEM = "Bass: ";
+static const char labelTreble[] PROGMEM = "Treble: ";
+static const char labelChannel[] PROGMEM = "Channel: ";
+static const char labelOutput[] PROGMEM = "Output: ";
+static const char labelExit[] PROGMEM = "Exit";
+
+static const char inputNone[] PROGMEM = "";
+static const char inputLine1One[] PROGMEM = "BT L";
+static const char inputLine1Two[] PROGMEM = "Line L";
+static const char inputLine2One[] PROGMEM = "BT R";
+static const char inputLine2Two[] PROGMEM = "Line R";
+static const char inputStereoOne[] PROGMEM = "BT L+R";
+static const char inputStereoTwo[] PROGMEM = "Line L+R";
+
+static const char stereoMono[] PROGMEM = "Mono";
+static const char stereoLinear[] PROGMEM = "Stereo";
+static const char stereoPseudo[] PROGMEM = "Pseudo";
+static const char stereoSpatial[] PROGMEM = "Spatial";
+
+static const char outputSpeaker[] PROGMEM = "Speaker";
+static const char outputHeadphone[] PROGMEM = "HPhone";
+
+#if ENABLE_PROFILER
+static const char stageCapture[] PROGMEM = "Capture";
+static const char stageTransform[] PROGMEM = "Xform";
+static const char stageBands[] PROGMEM = "Bands";
+static const char stageStream[] PROGMEM = "Stream";
+static const char stageAGC[] PROGMEM = "AGC";
+static const char stageLevels[] PROGMEM = "Levels";
+static const char stageBarGraph[] PROGMEM = "Bars";
+static const char stageLCD[] PROGMEM = "LCD";
+static const char stageLoop[] PROGMEM = "Loop";
+
+// Profiled stage labels, indexed by the profiler stage identifier.
+static const char * const stageLabels[] PROGMEM = 
+{
+    stageCapture, stageTransform, stageBands, stageStream, stageAGC, stageLevels, stageBarGraph, stageLCD, stageLoop
+};
+#endif
+
+// Menu item labels, indexed by SettingsMenuState.
+static const char * const menuLabels[] PROGMEM = 
+{
+    labelInput, labelBass, labelTreble, labelChannel, labelOutput, labelExit
+};
+
+// Input selection labels, indexed by the input bits of the switch register (0x02 - 0x07).
+static const char * const inputLabels[] PROGMEM = 
+{
+    inputNone, inputNone, inputLine1One, inputLine1Two, inputLine2One, inputLine2Two, inputStereoOne, inputStereoTwo
+};
+
+// Stereo mode labels, indexed by the stereo mode bits of the switch register.
+static const char * const stereoLabels[] PROGMEM = 
+{
+    stereoMono, stereoLinear, stereoPseudo, stereoSpatial
+};
+
+// Audio output labels, indexed by the audio output mode.
+static const char * const outputLabels[] PROGMEM = 
+{
+    outputSpeaker, outputHeadphone
+};
+
+static void printLabel(const char * const *table, unsigned char index)
+{
+    frameBuffer.print((const __FlashStringHelper *)pgm_read_ptr(&table[index]));
+}
 
 void showMute()
 {
-    lcd.clear();
-    lcd.print("     MUTE     ");
+    frameBuffer.clear();
+    frameBuffer.print(F("     MUTE     "));
 }
 
 void clearRow(unsigned char row)
 {
     char tempPos;
 
-    lcd.setCursor(0, row);
+    frameBuffer.setCursor(0, row);
 
-    for(tempPos = 0; tempPos < 16; tempPos++)
+    for(tempPos = 0; tempPos < LCD_COLUMNS; tempPos++)
     {
-        lcd.write(' ');
+        frameBuffer.write(' ');
     }
 
     // Return cursor to the home position of the specified row.
-    lcd.setCursor(0, row);
+    frameBuffer.setCursor(0, row);
 }
 
 void displayVolumeLevel(unsigned char lvlVolume)
 {
-    lcd.clear();
-    lcd.print("Volume: ");
-    lcd.print(lvlVolume);
+    frameBuffer.clear();
+    frameBuffer.print(F("Volume: "));
+    frameBuffer.print(lvlVolume);
 }
 
 void displayMenuItem(SettingsMenuState *menuState, AudioSettings *audioSettings, unsigned char *outputMode)
 {
-    unsigned char tempBuffer;
-    
     clearRow(1);
+    printLabel(menuLabels, *menuState);
 
     switch(*menuState)
     {
         case INPUT_CHANNEL:     // Input mode selection.
-            lcd.print("Input: ");   
-            tempBuffer = (audioSettings->switchConfig) & 0x07;
-            switch (tempBuffer)
-            {
-                case SWITCH_STEREO_ONE_CHANNEL: // Line L+R.
-                    lcd.print("BT L+R");
-                    break;
-                case SWITCH_STEREO_TWO_CHANNEL: // Bluetooth L+R.
-                    lcd.print("Line L+R");
-                    break;
-                case SWITCH_LINE1_ONE_CHANNEL:  // Line Left.
-                    lcd.print("BT L");
-                    break;
-                case SWITCH_LINE2_ONE_CHANNEL:  // Bluetooth Left.
-                    lcd.print("BT R");
-                    break;
-                case SWITCH_LINE1_TWO_CHANNEL:  // Line Right.
-                    lcd.print("Line L");
-                    break;
-                case SWITCH_LINE2_TWO_CHANNEL:  // Bluetooth Right.
-                    lcd.print("Line R");
-                    break;
-            }
+            printLabel(inputLabels, (audioSettings->switchConfig) & 0x07);
             break;
-        case LVL_BASS:      // Bass level.
-            lcd.print("Bass: "); 
-            lcd.print(((char)(audioSettings->bass)) - 6);
+        case LVL_BASS:          // Bass level.
+            frameBuffer.print(((char)(audioSettings->bass)) - 6);
             break;
-        case LVL_TREBLE:    // Treble level.
-            lcd.print("Treble: "); 
-            lcd.print(((char)(audioSettings->treble)) - 6);
+        case LVL_TREBLE:        // Treble level.
+            frameBuffer.print(((char)(audioSettings->treble)) - 6);
             break;
-        case MODE_STEREO:   // Stereo configuration.
-            lcd.print("Channel: ");
-            tempBuffer = (audioSettings->switchConfig) & 0x18;
-            switch (tempBuffer)
-            {
-                case SWITCH_SPATIAL_STEREO_TDA8425:
-                    lcd.print("Spatial");
-                    break;
-                case SWITCH_LINEAR_STEREO_TDA8425:
-                    lcd.print("Stereo");
-                    break;
-                case SWITCH_PSEUDO_STEREO_TDA8425:
-                    lcd.print("Pseudo");
-                    break;
-                case SWITCH_MONO_TDA8425:
-                    lcd.print("Mono");
-                    break;
-            }
+        case MODE_STEREO:       // Stereo configuration.
+            printLabel(stereoLabels, ((audioSettings->switchConfig) & 0x18) >> 3);
             break;
-        case OUTPUT_MODE:   // Audio output mode.
-            lcd.print("Output: ");
-            lcd.print(((*outputMode) == AUDIO_OUT_SPEAKER) ? "Speaker" : "HPhone");
+        case OUTPUT_MODE:       // Audio output mode.
+            printLabel(outputLabels, ((*outputMode) == AUDIO_OUT_SPEAKER) ? AUDIO_OUT_SPEAKER : AUDIO_OUT_HEADPHONE);
             break;
-        case EXIT:          // Exit from settings menu.
-            lcd.print("Exit");
+        case EXIT:              // Exit from settings menu.
             break;
     }
-}
\ No newline at end of file
+}
+
+#if ENABLE_PROFILER
+static void printFrameRate(unsigned short frameRate)
+{
+    // Frame rate is in 0.1 frames per second.
+    frameBuffer.print(frameRate / 10);
+    frameBuffer.write('.');
+    frameBuffer.print(frameRate % 10);
+    frameBuffer.print(F("fps"));
+}
+
+void displayDiagnostics(unsigned char page)
+{
+    ProfileStats stats;
+
+    frameBuffer.clear();
+
+    if(page == 0)
+    {
+        frameBuffer.print(F("Frame  "));
+        printFrameRate(getProfileFrameRate(PROFILE_ANALYZER_FRAME));
+        frameBuffer.setCursor(0, 1);
+        frameBuffer.print(F("Render "));
+        printFrameRate(getProfileFrameRate(PROFILE_RENDER_FRAME));
+        return;
+    }
+
+    // Average on the first row, minimum and maximum on the second row (in microseconds).
+    getProfileStats(page - 1, &stats);
+
+    printLabel(stageLabels, page - 1);
+    frameBuffer.setCursor(8, 0);
+    frameBuffer.print((unsigned long)stats.avgTicks * PROFILE_CYCLES_PER_TICK / (F_CPU / 1000000UL));
+    frameBuffer.print(F("us"));
+
+    frameBuffer.setCursor(0, 1);
+    frameBuffer.print((unsigned long)stats.minTicks * PROFILE_CYCLES_PER_TICK / (F_CPU / 1000000UL));
+    frameBuffer.print(F(" - "));
+    frameBuffer.print((unsigned long)stats.maxTicks * PROFILE_CYCLES_PER_TICK / (F_CPU / 1000000UL));
+}
+#endif
@@ -0,0 +1,134 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "eepromqueue.h"
+#include "common.h"
+
+#include <Arduino.h>
+#include <util/atomic.h>
+
+#define EEPROM_QUEUE_NEXT(pos)  (((pos) + 1) & (EEPROM_QUEUE_SIZE - 1))
+
+typedef struct
+{
+    unsigned short address;
+    unsigned char value;
+} EEPROMWrite;
+
+static EEPROMWrite eepromQueue[EEPROM_QUEUE_SIZE];
+static volatile unsigned char queueHead, queueTail;
+
+void initEEPROMQueue()
+{
+    queueHead = 0;
+    queueTail = 0;
+
+    // EE_READY interrupt is enabled only while there are pending writes.
+    EECR &= ~_BV(EERIE);
+}
+
+unsigned char eepromWrite(unsigned short address, unsigned char value)
+{
+    unsigned char isQueued = FALSE;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        if(EEPROM_QUEUE_NEXT(queueHead) != queueTail)
+        {
+            eepromQueue[queueHead].address = address;
+            eepromQueue[queueHead].value = value;
+            queueHead = EEPROM_QUEUE_NEXT(queueHead);
+            isQueued = TRUE;
+
+            // ISR fires as soon as the EEPROM is ready for the next write.
+            EECR |= _BV(EERIE);
+        }
+    }
+
+    return isQueued;
+}
+
+unsigned char getEEPROMQueueFree()
+{
+    unsigned char count;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        count = (queueTail - queueHead - 1) & (EEPROM_QUEUE_SIZE - 1);
+    }
+
+    return count;
+}
+
+unsigned char getEEPROMPendingWrites()
+{
+    unsigned char count;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        count = (queueHead - queueTail) & (EEPROM_QUEUE_SIZE - 1);
+
+        // Last write is still in progress after its entry is removed from the queue.
+        if(EECR & _BV(EEPE))
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+unsigned char isEEPROMQueueIdle()
+{
+    return (getEEPROMPendingWrites() == 0) ? TRUE : FALSE;
+}
+
+ISR(EE_READY_vect)
+{
+    EEPROMWrite *entry;
+
+    while(queueTail != queueHead)
+    {
+        entry = &eepromQueue[queueTail];
+        queueTail = EEPROM_QUEUE_NEXT(queueTail);
+
+        // Read the current value to skip unchanged bytes (read takes 4 cycles).
+        EEAR = entry->address;
+        EECR |= _BV(EERE);
+
+        if(EEDR != entry->value)
+        {
+            // Erase and write (~3.4ms), EEPE must be set within 4 cycles after EEMPE. The ISR 
+            // fires again once the write is complete.
+            EEDR = entry->value;
+            EECR |= _BV(EEMPE);
+            EECR |= _BV(EEPE);
+            return;
+        }
+    }
+
+    // Queue is empty, disable the interrupt until the next write is posted.
+    EECR &= ~_BV(EERIE);
+}
@@ -0,0 +1,122 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "fftq15.h"
+#include "q15math.h"
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+// Quarter wave of the sine table, sin(PI * i / 128) in Q15 format.
+static const short sineTable[FFT_ANGLE_QUARTER_CIRCLE + 1] PROGMEM =
+{
+    0, 804, 1608, 2410, 3212, 4011, 4808, 5602,
+    6393, 7179, 7962, 8739, 9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+    27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+    32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767
+};
+
+void getTwiddle(unsigned char angle, short *cosValue, short *sinValue)
+{
+    // Angle is in the range of 0 to PI (exclusive).
+    if(angle <= FFT_ANGLE_QUARTER_CIRCLE)
+    {
+        *sinValue = (short)pgm_read_word(&sineTable[angle]);
+        *cosValue = (short)pgm_read_word(&sineTable[FFT_ANGLE_QUARTER_CIRCLE - angle]);
+    }
+    else
+    {
+        *sinValue = (short)pgm_read_word(&sineTable[FFT_ANGLE_HALF_CIRCLE - angle]);
+        *cosValue = -(short)pgm_read_word(&sineTable[angle - FFT_ANGLE_QUARTER_CIRCLE]);
+    }
+}
+
+static void bitReverse(short *fftReal, short *fftImg, unsigned char points)
+{
+    unsigned char pos, revPos, bitMask;
+    short temp;
+
+    for(pos = 1, revPos = 0; pos < points; pos++)
+    {
+        // Increment the bit reversed index.
+        bitMask = points >> 1;
+        while(revPos & bitMask)
+        {
+            revPos &= ~bitMask;
+            bitMask >>= 1;
+        }
+        revPos |= bitMask;
+
+        if(pos < revPos)
+        {
+            temp = fftReal[pos];
+            fftReal[pos] = fftReal[revPos];
+            fftReal[revPos] = temp;
+
+            temp = fftImg[pos];
+            fftImg[pos] = fftImg[revPos];
+            fftImg[revPos] = temp;
+        }
+    }
+}
+
+void fftQ15(short *fftReal, short *fftImg, unsigned char order)
+{
+    unsigned char points = 1 << order;
+    unsigned char span, group, pos, pairPos, angleStep;
+    short cosValue, sinValue, tempReal, tempImg;
+
+    bitReverse(fftReal, fftImg, points);
+
+    // Radix-2 decimation in time. Each stage is scaled by 1/2 to avoid overflows, so the output 
+    // is the DFT divided by the number of points. Input magnitude must be below 0.707 (Q15).
+    for(span = 1, angleStep = FFT_ANGLE_HALF_CIRCLE; span < points; span <<= 1, angleStep >>= 1)
+    {
+        for(group = 0; group < span; group++)
+        {
+            // Twiddle factor W = cos(a) - j.sin(a), where a = PI * group / span.
+            getTwiddle(group * angleStep, &cosValue, &sinValue);
+
+            for(pos = group; pos < points; pos += (span << 1))
+            {
+                pairPos = pos + span;
+
+                // Butterfly with the scaled operands.
+                tempReal = (mulQ15(cosValue, fftReal[pairPos]) + mulQ15(sinValue, fftImg[pairPos])) >> 1;
+                tempImg = (mulQ15(cosValue, fftImg[pairPos]) - mulQ15(sinValue, fftReal[pairPos])) >> 1;
+
+                fftReal[pairPos] = (fftReal[pos] >> 1) - tempReal;
+                fftImg[pairPos] = (fftImg[pos] >> 1) - tempImg;
+                fftReal[pos] = (fftReal[pos] >> 1) + tempReal;
+                fftImg[pos] = (fftImg[pos] >> 1) + tempImg;
+            }
+        }
+    }
+}
@@ -0,0 +1,169 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "goertzel.h"
+#include "common.h"
+#include "constmath.h"
+#include "bands.h"
+#include "spectrum.h"
+#include "q15math.h"
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#include <string.h>
+
+static_assert(GOERTZEL_BANDS <= BAND_MAX_COLUMNS, "Too many Goertzel bands");
+
+// Magnitudes are scaled by 2/N to match the FFT engine (see computeSpectrum).
+#if ANALYZER_SAMPLES == 256
+#define GOERTZEL_SCALE_SHIFT    7
+#else
+#define GOERTZEL_SCALE_SHIFT    6
+#endif
+
+typedef struct GoertzelCoef
+{
+    short cosValue;
+    short sinValue;
+} GoertzelCoef;
+
+// Band center frequencies are spaced logarithmically between the lowest and the highest 
+// frequency (limited to the Nyquist frequency), in the middle of each band.
+constexpr double GOERTZEL_MAX_FREQ = constMin(ANALYZER_BAND_MAX_FREQ, ANALYZER_SAMPLE_RATE / 2.0);
+constexpr double GOERTZEL_RATIO = constRoot(GOERTZEL_MAX_FREQ / ANALYZER_BAND_MIN_FREQ, GOERTZEL_BANDS, 1.5, 32);
+constexpr double GOERTZEL_HALF_RATIO = constRoot(GOERTZEL_RATIO, 2, 1.0, 16);
+
+constexpr double goertzelOmega(unsigned char band)
+{
+    return (2 * CONST_PI * ANALYZER_BAND_MIN_FREQ * constPower(GOERTZEL_RATIO, band) * GOERTZEL_HALF_RATIO) / ANALYZER_SAMPLE_RATE;
+}
+
+#define GOERTZEL_COEF(band) {constQ15(constCos(goertzelOmega(band))), constQ15(constSin(goertzelOmega(band)))}
+
+// Q15 cosine and sine of the center frequency of each band.
+static const GoertzelCoef goertzelCoefTable[BAND_MAX_COLUMNS] PROGMEM = 
+{
+    GOERTZEL_COEF(0), GOERTZEL_COEF(1), GOERTZEL_COEF(2), GOERTZEL_COEF(3), 
+    GOERTZEL_COEF(4), GOERTZEL_COEF(5), GOERTZEL_COEF(6), GOERTZEL_COEF(7), 
+    GOERTZEL_COEF(8), GOERTZEL_COEF(9), GOERTZEL_COEF(10), GOERTZEL_COEF(11), 
+    GOERTZEL_COEF(12), GOERTZEL_COEF(13), GOERTZEL_COEF(14), GOERTZEL_COEF(15)
+};
+
+// Filter states of the per-sample engine, and the states latched at the end of the last frame.
+static long filterState1[GOERTZEL_BANDS], filterState2[GOERTZEL_BANDS];
+static long latchState1[GOERTZEL_BANDS], latchState2[GOERTZEL_BANDS];
+static volatile unsigned char isLatchReady = FALSE;
+
+// Filter recurrence s[n] = x[n] + 2.cos(w).s[n-1] - s[n-2], with 2.cos(w) = 4 * (cos(w) in Q15 >> 16).
+static inline long goertzelStep(short sample, long state1, long state2, short cosValue) __attribute__((always_inline));
+
+static inline long goertzelStep(short sample, long state1, long state2, short cosValue)
+{
+    return sample + (mulLongHigh(state1, cosValue) * 4) - state2;
+}
+
+static unsigned short getBandMagnitude(unsigned char band, long state1, long state2)
+{
+    long real, img;
+    short cosValue = pgm_read_word(&goertzelCoefTable[band].cosValue);
+    short sinValue = pgm_read_word(&goertzelCoefTable[band].sinValue);
+
+    // X = s[N-1] - e^(-jw).s[N-2], phase of the result is not used.
+    real = state1 - (mulLongHigh(state2, cosValue) * 2);
+    img = mulLongHigh(state2, sinValue) * 2;
+
+    return estimateMagnitude(real >> GOERTZEL_SCALE_SHIFT, img >> GOERTZEL_SCALE_SHIFT);
+}
+
+void computeGoertzel(short *samples, unsigned short *bands)
+{
+    unsigned char band, samplePos;
+    short cosValue;
+    long state1, state2;
+
+    for(band = 0; band < GOERTZEL_BANDS; band++)
+    {
+        cosValue = pgm_read_word(&goertzelCoefTable[band].cosValue);
+        state1 = 0;
+        state2 = 0;
+
+        // Even samples are in the first half and odd samples in the second half of the frame, 
+        // each pair of samples is processed in time order (states are swapped on every step).
+        for(samplePos = 0; samplePos < (ANALYZER_SAMPLES / 2); samplePos++)
+        {
+            state2 = goertzelStep(samples[samplePos], state1, state2, cosValue);
+            state1 = goertzelStep(samples[samplePos + (ANALYZER_SAMPLES / 2)], state2, state1, cosValue);
+        }
+
+        bands[band] = getBandMagnitude(band, state1, state2);
+    }
+}
+
+void updateGoertzel(short sample)
+{
+    unsigned char band;
+    long state;
+
+    for(band = 0; band < GOERTZEL_BANDS; band++)
+    {
+        state = goertzelStep(sample, filterState1[band], filterState2[band], pgm_read_word(&goertzelCoefTable[band].cosValue));
+        filterState2[band] = filterState1[band];
+        filterState1[band] = state;
+    }
+}
+
+void latchGoertzel()
+{
+    // Keep the previous frame if it is not yet processed by the analyzer.
+    if(isLatchReady == FALSE)
+    {
+        memcpy(latchState1, filterState1, sizeof(filterState1));
+        memcpy(latchState2, filterState2, sizeof(filterState2));
+        isLatchReady = TRUE;
+    }
+
+    // Start the next frame.
+    memset(filterState1, 0, sizeof(filterState1));
+    memset(filterState2, 0, sizeof(filterState2));
+}
+
+unsigned char getGoertzelBands(unsigned short *bands)
+{
+    unsigned char band;
+
+    if(isLatchReady == FALSE)
+    {
+        return FALSE;
+    }
+
+    for(band = 0; band < GOERTZEL_BANDS; band++)
+    {
+        bands[band] = getBandMagnitude(band, latchState1[band], latchState2[band]);
+    }
+
+    // Release the latched states to the ADC ISR.
+    isLatchReady = FALSE;
+    return TRUE;
+}
@@ -0,0 +1,304 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "i2cqueue.h"
+#include "fastpin.h"
+#include "common.h"
+
+#include <Arduino.h>
+#include <util/atomic.h>
+
+// TWI status codes (master transmitter mode).
+#define TW_START            0x08
+#define TW_REP_START        0x10
+#define TW_MT_SLA_ACK       0x18
+#define TW_MT_SLA_NACK      0x20
+#define TW_MT_DATA_ACK      0x28
+#define TW_MT_DATA_NACK     0x30
+#define TW_MT_ARB_LOST      0x38
+#define TW_BUS_ERROR        0x00
+
+#define TW_STATUS_MASK      0xF8
+
+#define I2C_QUEUE_NEXT(pos) (((pos) + 1) & (I2C_QUEUE_SIZE - 1))
+
+typedef struct
+{
+    unsigned char address;
+    unsigned char subAddr;
+    unsigned char length;
+    unsigned char data[I2C_MAX_DATA_SIZE];
+} I2CTransaction;
+
+static I2CTransaction i2cQueue[I2C_QUEUE_SIZE];
+static volatile unsigned char queueHead, queueTail;
+static volatile unsigned char isBusy;
+
+// Time of the last TWI event (lower 16 bits of millis()), used to detect a hung bus.
+static volatile unsigned short eventTime;
+
+// Position of the next byte of the active transaction (0 is sub-address, data follows).
+static unsigned char bytePos;
+
+static I2CCallback completeCallback = NULL;
+static I2CCallback errorCallback = NULL;
+
+// Start the next pending transaction, or release the bus if there is nothing to send. 
+// Called from the TWI ISR or with the interrupts disabled.
+static void startNextTransaction(unsigned char isStopRequired)
+{
+    unsigned char control = _BV(TWINT) | _BV(TWEN) | ((isStopRequired) ? _BV(TWSTO) : 0);
+
+    if(queueTail != queueHead)
+    {
+        // STOP (if required) followed by a START condition.
+        isBusy = TRUE;
+        bytePos = 0;
+        eventTime = millis();
+        TWCR = control | _BV(TWSTA) | _BV(TWIE);
+    }
+    else
+    {
+        isBusy = FALSE;
+        TWCR = control;
+    }
+}
+
+static void finishTransaction(unsigned char status)
+{
+    I2CTransaction *transaction = &i2cQueue[queueTail];
+    
+    if(status == I2C_STATUS_OK)
+    {
+        if(completeCallback != NULL)
+        {
+            completeCallback(transaction->address, transaction->subAddr, status);
+        }
+    }
+    else if(errorCallback != NULL)
+    {
+        errorCallback(transaction->address, transaction->subAddr, status);
+    }
+
+    queueTail = I2C_QUEUE_NEXT(queueTail);
+}
+
+void initI2CQueue()
+{
+    queueHead = 0;
+    queueTail = 0;
+    isBusy = FALSE;
+
+    // Activate internal pull-ups on SDA and SCL lines.
+    FastPin<SDA>::setInputPullup();
+    FastPin<SCL>::setInputPullup();
+
+    // Set bit rate with prescaler value of 1.
+    TWSR &= ~(_BV(TWPS0) | _BV(TWPS1));
+    TWBR = ((F_CPU / I2C_CLOCK_FREQ) - 16) / 2;
+
+    TWCR = _BV(TWEN);
+}
+
+void setI2CCallbacks(I2CCallback onComplete, I2CCallback onError)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        completeCallback = onComplete;
+        errorCallback = onError;
+    }
+}
+
+unsigned char i2cWrite(unsigned char address, unsigned char subAddr, const unsigned char *data, unsigned char length)
+{
+    unsigned char pos, dataPos;
+    unsigned char status = I2C_STATUS_OK;
+    I2CTransaction *transaction, *lastTransaction = NULL;
+
+    if((length == 0) || (length > I2C_MAX_DATA_SIZE))
+    {
+        return I2C_STATUS_INVALID;
+    }
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        // Find the latest pending write to the device, the transaction at the tail is already on 
+        // the bus if the driver is busy.
+        pos = (isBusy) ? I2C_QUEUE_NEXT(queueTail) : queueTail;
+        while(pos != queueHead)
+        {
+            if(i2cQueue[pos].address == address)
+            {
+                lastTransaction = &i2cQueue[pos];
+            }
+
+            pos = I2C_QUEUE_NEXT(pos);
+        }
+
+        if((lastTransaction != NULL) && (lastTransaction->subAddr == subAddr) && (lastTransaction->length == length))
+        {
+            // Same registers are written again, update the pending write with the new data.
+            transaction = lastTransaction;
+        }
+        else if(I2C_QUEUE_NEXT(queueHead) != queueTail)
+        {
+            transaction = &i2cQueue[queueHead];
+            transaction->address = address;
+            transaction->subAddr = subAddr;
+            transaction->length = length;
+
+            queueHead = I2C_QUEUE_NEXT(queueHead);
+        }
+        else
+        {
+            // Queue is full, caller retries later.
+            transaction = NULL;
+            status = I2C_STATUS_BUSY;
+        }
+
+        if(transaction != NULL)
+        {
+            for(dataPos = 0; dataPos < length; dataPos++)
+            {
+                transaction->data[dataPos] = data[dataPos];
+            }
+
+            if(isBusy == FALSE)
+            {
+                startNextTransaction(FALSE);
+            }
+        }
+    }
+
+    return status;
+}
+
+unsigned char isI2CQueueIdle()
+{
+    return (isBusy) ? FALSE : TRUE;
+}
+
+static void recoverBus()
+{
+    unsigned char clockPos;
+
+    // TWI is disabled, drive SCL as open drain until the slave releases SDA.
+    for(clockPos = 0; (clockPos < I2C_RECOVERY_CLOCKS) && (FastPin<SDA>::read() == LOW); clockPos++)
+    {
+        FastPin<SCL>::low();
+        FastPin<SCL>::setOutput();
+        delayMicroseconds(5);
+        FastPin<SCL>::setInputPullup();
+        delayMicroseconds(5);
+    }
+
+    // STOP condition (SDA rising while SCL is high) brings the slaves to idle state.
+    FastPin<SDA>::low();
+    FastPin<SDA>::setOutput();
+    delayMicroseconds(5);
+    FastPin<SDA>::setInputPullup();
+    delayMicroseconds(5);
+}
+
+void serviceI2CQueue()
+{
+    unsigned char isTimeout = FALSE;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        if(isBusy && ((unsigned short)((unsigned short)millis() - eventTime) > I2C_TIMEOUT))
+        {
+            // Release the TWI, the queue stays busy so no new transaction is started.
+            TWCR = 0;
+            isTimeout = TRUE;
+        }
+    }
+
+    if(isTimeout == FALSE)
+    {
+        return;
+    }
+
+    // Bus is recovered with the interrupts enabled (takes up to ~100us).
+    recoverBus();
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        finishTransaction(I2C_STATUS_TIMEOUT);
+        TWCR = _BV(TWEN);
+        startNextTransaction(FALSE);
+    }
+}
+
+ISR(TWI_vect)
+{
+    I2CTransaction *transaction = &i2cQueue[queueTail];
+
+    eventTime = millis();
+
+    switch(TWSR & TW_STATUS_MASK)
+    {
+        case TW_START:
+        case TW_REP_START:
+            // Send slave address with write flag.
+            TWDR = transaction->address << 1;
+            TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWIE);
+            break;
+        case TW_MT_SLA_ACK:
+        case TW_MT_DATA_ACK:
+            if(bytePos <= transaction->length)
+            {
+                // Sub-address is followed by the data bytes.
+                TWDR = (bytePos == 0) ? transaction->subAddr : transaction->data[bytePos - 1];
+                TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWIE);
+                bytePos++;
+            }
+            else
+            {
+                finishTransaction(I2C_STATUS_OK);
+                startNextTransaction(TRUE);
+            }
+            break;
+        case TW_MT_SLA_NACK:
+            finishTransaction(I2C_STATUS_ADDR_NACK);
+            startNextTransaction(TRUE);
+            break;
+        case TW_MT_DATA_NACK:
+            finishTransaction(I2C_STATUS_DATA_NACK);
+            startNextTransaction(TRUE);
+            break;
+        case TW_MT_ARB_LOST:
+            // Bus is released by the hardware, retry is not attempted.
+            finishTransaction(I2C_STATUS_ARBITRATION_LOST);
+            startNextTransaction(FALSE);
+            break;
+        default:
+            // Bus error, reset the TWI hardware.
+            finishTransaction(I2C_STATUS_BUS_ERROR);
+            TWCR = 0;
+            startNextTransaction(TRUE);
+            break;
+    }
+}
@@ -0,0 +1,126 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "lcddriver.h"
+#include "fastpin.h"
+#include "common.h"
+
+#include <Arduino.h>
+#include <util/delay.h>
+#include <avr/pgmspace.h>
+
+typedef FastPin<LCD_RS> LCDPinRS;
+typedef FastPin<LCD_EN> LCDPinEN;
+typedef FastPin<LCD_D4> LCDPinD4;
+
+// Data lines must occupy the upper or lower nibble of a single port in D4..D7 order.
+static_assert((LCDPinD4::bit == 0) || (LCDPinD4::bit == 4), "LCD_D4 must be bit 0 or 4 of the port");
+static_assert((FastPin<LCD_D5>::portId == LCDPinD4::portId) && (FastPin<LCD_D5>::bit == (LCDPinD4::bit + 1)), "LCD_D5 must follow LCD_D4");
+static_assert((FastPin<LCD_D6>::portId == LCDPinD4::portId) && (FastPin<LCD_D6>::bit == (LCDPinD4::bit + 2)), "LCD_D6 must follow LCD_D5");
+static_assert((FastPin<LCD_D7>::portId == LCDPinD4::portId) && (FastPin<LCD_D7>::bit == (LCDPinD4::bit + 3)), "LCD_D7 must follow LCD_D6");
+
+#define LCD_DATA_MASK   (0x0F << LCDPinD4::bit)
+
+// Execution time of the most of the HD44780 instructions is 37us.
+#define LCD_EXEC_DELAY_US   40
+#define LCD_CLEAR_DELAY_US  2000
+
+static inline void lcdWriteNibble(unsigned char nibble)
+{
+    volatile unsigned char &dataPort = LCDPinD4::port();
+
+    // Update D4..D7 with a single port write and latch it with the enable pulse (>450ns).
+    dataPort = (dataPort & ~LCD_DATA_MASK) | ((nibble & 0x0F) << LCDPinD4::bit);
+    
+    LCDPinEN::high();
+    _delay_us(0.5);
+    LCDPinEN::low();
+}
+
+static void lcdWriteByte(unsigned char value, unsigned char isData)
+{
+    LCDPinRS::write(isData);
+
+    lcdWriteNibble(value >> 4);
+    lcdWriteNibble(value);
+
+    // There is no busy flag (R/W is tied to ground), wait for the instruction to complete.
+    _delay_us(LCD_EXEC_DELAY_US);
+}
+
+void lcdInit()
+{
+    LCDPinRS::setOutput();
+    LCDPinEN::setOutput();
+    LCDPinD4::ddr() |= LCD_DATA_MASK;
+
+    LCDPinRS::low();
+    LCDPinEN::low();
+
+    // Wait for the LCD to power up and switch it to 4-bit mode (initialization by instruction).
+    _delay_ms(50);
+
+    lcdWriteNibble(0x03);
+    _delay_us(4500);
+    lcdWriteNibble(0x03);
+    _delay_us(4500);
+    lcdWriteNibble(0x03);
+    _delay_us(150);
+    lcdWriteNibble(0x02);
+    _delay_us(LCD_EXEC_DELAY_US);
+
+    lcdWriteByte(LCD_CMD_FUNCTION_SET, FALSE);
+    lcdWriteByte(LCD_CMD_DISPLAY_ON, FALSE);
+    lcdClear();
+    lcdWriteByte(LCD_CMD_ENTRY_MODE, FALSE);
+}
+
+void lcdClear()
+{
+    lcdWriteByte(LCD_CMD_CLEAR, FALSE);
+    _delay_us(LCD_CLEAR_DELAY_US);
+}
+
+void lcdSetCursor(unsigned char col, unsigned char row)
+{
+    lcdWriteByte(LCD_CMD_SET_DDRAM_ADDR | (col + ((row) ? LCD_ROW1_ADDR : 0x00)), FALSE);
+}
+
+void lcdWrite(unsigned char value)
+{
+    lcdWriteByte(value, TRUE);
+}
+
+void lcdCreateChar(unsigned char location, const unsigned char *charMap)
+{
+    unsigned char row;
+
+    lcdWriteByte(LCD_CMD_SET_CGRAM_ADDR | ((location & 0x07) << 3), FALSE);
+
+    for(row = 0; row < 8; row++)
+    {
+        lcdWrite(pgm_read_byte(&charMap[row]));
+    }
+}
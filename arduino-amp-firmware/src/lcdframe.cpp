@@ -0,0 +1,105 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "lcdframe.h"
+#include "lcddriver.h"
+#include "common.h"
+
+#include <Arduino.h>
+#include <string.h>
+
+LCDFrameBuffer::LCDFrameBuffer()
+{
+    cursorCol = 0;
+    cursorRow = 0;
+}
+
+void LCDFrameBuffer::begin()
+{
+    // Start with a blank LCD and keep the shadow copy in sync with it.
+    lcdClear();
+    
+    memset(frame, ' ', sizeof(frame));
+    memset(shadow, ' ', sizeof(shadow));
+
+    cursorCol = 0;
+    cursorRow = 0;
+}
+
+void LCDFrameBuffer::clear()
+{
+    // Only the frame buffer is cleared, LCD is updated on the next flush.
+    memset(frame, ' ', sizeof(frame));
+
+    cursorCol = 0;
+    cursorRow = 0;
+}
+
+void LCDFrameBuffer::setCursor(unsigned char col, unsigned char row)
+{
+    cursorCol = col;
+    cursorRow = (row < LCD_ROWS) ? row : (LCD_ROWS - 1);
+}
+
+size_t LCDFrameBuffer::write(uint8_t value)
+{
+    // Characters beyond the visible area of the row are dropped.
+    if(cursorCol < LCD_COLUMNS)
+    {
+        frame[cursorRow][cursorCol] = value;
+        cursorCol++;
+    }
+
+    return 1;
+}
+
+void LCDFrameBuffer::flush()
+{
+    unsigned char row, col;
+    unsigned char lcdCol;
+
+    for(row = 0; row < LCD_ROWS; row++)
+    {
+        lcdCol = LCD_CURSOR_UNKNOWN;
+
+        for(col = 0; col < LCD_COLUMNS; col++)
+        {
+            if(frame[row][col] != shadow[row][col])
+            {
+                // Issue cursor command only at the beginning of each changed run, LCD 
+                // address counter moves to the next column after every write.
+                if(lcdCol != col)
+                {
+                    lcdSetCursor(col, row);
+                }
+
+                lcdWrite(frame[row][col]);
+                shadow[row][col] = frame[row][col];
+
+                lcdCol = col + 1;
+            }
+        }
+    }
+}
@@ -27,50 +27,56 @@
 #include "tda8425.h"
 #include "yda138.h"
 #include "displayutil.h"
+#include "adcsampler.h"
+#include "lcdframe.h"
+#include "lcddriver.h"
+#include "scheduler.h"
+#include "buttons.h"
+#include "i2cqueue.h"
+#include "spectrum.h"
+#include "bands.h"
+#include "goertzel.h"
+#include "bargraph.h"
+#include "autogain.h"
+#include "arena.h"
+#include "configstore.h"
+#include "eepromqueue.h"
+#include "volumeramp.h"
+#include "remoteproto.h"
+#include "spectrumstream.h"
+#include "profiler.h"
 
 #include <Arduino.h>
-#include <Wire.h>
 #include <EEPROM.h>
-#include <LiquidCrystal.h>
-#include <fix_fft.h>
+#include <string.h>
 
-#define ANALYZER_SAMPLES        128
-#define ANALYZER_COLUMNS        16
-#define LCD_MAX_COLUMN_HEIGHT   16
-
-unsigned char btnState_Action, btnState_Up, btnState_Down, btnState_Mute;
-unsigned short idleCounter;
-unsigned char audioOutMode, isAudioMute, isLCDShowMute;
+unsigned char audioOutMode, isAudioMute;
+unsigned char uiMode;
+SettingsMenuState menuState;
 AudioSettings audioSettings;
 
-LiquidCrystal lcd(LCD_RS, LCD_EN, LCD_D4, LCD_D5, LCD_D6, LCD_D7);
+unsigned char taskButtonEvents, taskAnalyzer, taskAnalyzerRender, taskSaveConfig, taskIdle, taskMenuTimeout, taskRemote;
+
+#if ENABLE_PROFILER
+unsigned char taskDiagnostics, diagPage, isActionLongPress;
+#endif
+
+LCDFrameBuffer frameBuffer;
 
-char analogData[ANALYZER_SAMPLES];
-char imgData[ANALYZER_SAMPLES];
-int graphData[ANALYZER_SAMPLES];
+SharedArena sharedArena;
 
-// Spectrum analyzer (bar-graph) character configuration.
-unsigned char graphLine1[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F};
-unsigned char graphLine2[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F};
-unsigned char graphLine3[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F};
-unsigned char graphLine4[] = {0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F};
-unsigned char graphLine5[] = {0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F};
-unsigned char graphLine6[] = {0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F};
-unsigned char graphLine7[] = {0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F};
+unsigned short bandData[ANALYZER_COLUMNS];
+
+// Processing time of the last analyzer frame (in microseconds).
+unsigned long analyzerFrameTime;
 
 void saveConfiguration(AudioSettings *audioSettings, unsigned char *outputMode)
 {
-    // Save audio configurations.
-    EEPROM.update(EEPROM_ADDR_VOLUME, audioSettings->volume);
-    EEPROM.update(EEPROM_ADDR_BASS, audioSettings->bass);
-    EEPROM.update(EEPROM_ADDR_TREBLE, audioSettings->treble);
-    EEPROM.update(EEPROM_ADDR_SWCONF, audioSettings->switchConfig);
-
-    // Save audio output mode.
-    EEPROM.update(EEPROM_ADDR_OUTPUT, *outputMode);
+    // Append audio configuration and output mode to the settings log as a single record.
+    writeConfigRecord(audioSettings, *outputMode);
 }
 
-unsigned char loadLastConfiguration(AudioSettings *audioSettings, unsigned char *outputMode)
+unsigned char loadLegacyConfiguration(AudioSettings *audioSettings, unsigned char *outputMode)
 {
     AudioSettings tempSettings;
     unsigned char tempOutputMode;
@@ -115,456 +121,816 @@ unsigned char loadLastConfiguration(AudioSettings *audioSettings, unsigned char
     return isValueUpdate;
 }
 
-void drawSpectrumAnalyzer()
+unsigned char loadLastConfiguration(AudioSettings *audioSettings, unsigned char *outputMode)
 {
-    unsigned char arrayPos = 1;
-    unsigned char lcdPos = 0;
-    int barVal;
-
-    while(lcdPos < ANALYZER_COLUMNS)
-    {        
-        // Check graph data is moving more than one LCD row.
-        if(graphData[arrayPos] > 8)
-        {            
-            barVal = graphData[arrayPos] - 8;  
-            
-            lcd.setCursor(lcdPos, 0);        
-
-            // Fill the top row of the LCD.
-            if(barVal > 0)
-            {     
-                lcd.write((char)((barVal < 8) ? barVal : 0xFF)); 
-            }
-            
-            // In this state bottom row of the LCD is always full.
-            barVal = 0xFF;                    
-        }
-        else
-        {
-            barVal = graphData[arrayPos];
-
-            // Check for valid graph data.
-            if(barVal > 0)
-            {
-                barVal = (barVal < 8) ? barVal : 0xFF;
-            }
-            else
-            {
-                // Graph data is not available for the selected frequency.
-                barVal = 0;
-            }
-        }
-
-        // Draw the bottom raw of the LCD.
-        lcd.setCursor(lcdPos, 1);
+    AudioSettings tempSettings;
+    unsigned char tempOutputMode;
 
-        if(barVal > 0)
-        {
-            lcd.write((char)barVal); 
-        }
+    if(readConfigRecord(&tempSettings, &tempOutputMode) == FALSE)
+    {
+        // Settings log is empty, configuration may be still in the old fixed address layout.
+        return loadLegacyConfiguration(audioSettings, outputMode);
+    }
 
-        // Move to next LCD column and frequency.
-        arrayPos += 2;
-        lcdPos++;
+    // Record is restored as a whole, only if all the values are in the valid range.
+    if((tempSettings.volume > VOLUME_TDA8425_MAX) || (tempSettings.bass > BASS_TDA8425_MAX) || 
+        (tempSettings.treble > TREBLE_TDA8425_MAX) || (tempOutputMode > AUDIO_OUT_HEADPHONE))
+    {
+        return FALSE;
     }
+
+    *audioSettings = tempSettings;
+    *outputMode = tempOutputMode;
+    return TRUE;
 }
 
-void automaticGainControl(int *graph)
+void updateSpectrumAnalyzer()
 {
-    unsigned char peekDataCount = 0;
-    unsigned char arrayPos;
-    int temp = 0;
+    unsigned long startTime = micros();
+    PROFILE_START(stageStart);
 
-    // Find the number of peek points across the spectrum and the maximum amplitude.
-    for(arrayPos = 1; arrayPos < ((ANALYZER_COLUMNS * 2) + 1); arrayPos++)
+#if ANALYZER_ENGINE == ANALYZER_ENGINE_GOERTZEL_ISR
+    // Filters are updated by the ADC interrupt, get the band magnitudes of the latest frame.
+    if(getGoertzelBands(bandData) == FALSE)
     {
-        if(graph[arrayPos] > LCD_MAX_COLUMN_HEIGHT)
-        {
-            peekDataCount++;
-        }
-
-        if(graph[arrayPos] > temp)
-        {
-            temp = graph[arrayPos];
-        }
+        // Sampling of the next frame is still in progress.
+        return;
     }
 
-    // Trim graph data based on the maximum amplitude.
-    if(peekDataCount >= (ANALYZER_COLUMNS / 2))
+    PROFILE_STAGE(PROFILE_CAPTURE, stageStart);
+#else
+    // Get the latest audio frame captured by the ADC interrupt.
+    if(getSampleFrame(sharedArena.analyzer.frame) == FALSE)
     {
-        temp = temp % LCD_MAX_COLUMN_HEIGHT;
-        if(temp > 0)
-        {
-            for(arrayPos = 1; arrayPos < ((ANALYZER_COLUMNS * 2) + 1); arrayPos++)
-            {
-                graph[arrayPos] = graph[arrayPos] / temp;
-            }
-        }
+        // Sampling of the next block is still in progress.
+        return;
     }
+
+    PROFILE_STAGE(PROFILE_CAPTURE, stageStart);
+
+#if ANALYZER_ENGINE == ANALYZER_ENGINE_GOERTZEL
+    // Run Goertzel filter at the center frequency of each band.
+    computeGoertzel(sharedArena.analyzer.frame, bandData);
+    PROFILE_STAGE(PROFILE_TRANSFORM, stageStart);
+#else
+    // Perform real FFT and extract magnitude of each frequency bin.
+    computeSpectrum(sharedArena.analyzer.frame, sharedArena.analyzer.bins);
+    PROFILE_STAGE(PROFILE_TRANSFORM, stageStart);
+
+    // Combine frequency bins into log-spaced bands (one per LCD column).
+    aggregateBands(sharedArena.analyzer.bins, bandData);
+#endif
+#endif
+
+    // Average the bands until the next display update.
+    averageBands(bandData);
+    PROFILE_STAGE(PROFILE_BANDS, stageStart);
+
+    analyzerFrameTime = micros() - startTime;
+
+    // Send the bands to the host (if the stream is enabled).
+    streamSpectrumFrame(bandData, getAutoGain());
+    PROFILE_STAGE(PROFILE_STREAM, stageStart);
+    PROFILE_FRAME(PROFILE_ANALYZER_FRAME);
 }
 
-void updateSpectrumAnalyzer()
+void renderSpectrumAnalyzer()
 {
-    unsigned char samplePos, tempPos;
-    char tempValue;
-
-    // Capture audio data from ADC channel 0.
-    for(samplePos = 0; samplePos < ANALYZER_SAMPLES; samplePos++)
-    { 
-        tempValue = analogRead(A0);
-        analogData[samplePos] = (char)(tempValue/4 - 128);
-        imgData[samplePos] = 0;
-    }
+    unsigned char bandPos;
+    PROFILE_START(stageStart);
 
-    // Perform FFT.
-    fix_fft(analogData, imgData, 7, 0);
+    getAverageBands(bandData);
 
-    // Extract absolute value from FFT data.
-    for(samplePos = 0; samplePos < (ANALYZER_SAMPLES/2); samplePos++)
-    {
-        graphData[samplePos] = (int)sqrt(analogData[samplePos] * analogData[samplePos] + imgData[samplePos] * imgData[samplePos]);
-    }
+    // Scale the bands to keep the display level stable.
+    applyAutoGain(bandData);
+    PROFILE_STAGE(PROFILE_AGC, stageStart);
 
-    for(samplePos = 0, tempPos = 0; samplePos < (ANALYZER_SAMPLES/2); samplePos++, tempPos += 2)
+    // Convert band data to display levels (in dB scale).
+    for(bandPos = 0; bandPos < ANALYZER_COLUMNS; bandPos++)
     {
-        graphData[samplePos] = graphData[tempPos] + graphData[tempPos + 1];
+        bandData[bandPos] = magnitudeToLevel(bandData[bandPos]);
     }
 
-    // Trim graph data to avoid clipping.
-    automaticGainControl(graphData);
+    PROFILE_STAGE(PROFILE_LEVELS, stageStart);
 
-    // Draw graph data on LCD.
-    lcd.clear();    
-    drawSpectrumAnalyzer();
+    // Move the bars towards the new levels and render them into the frame buffer (LCD is 
+    // updated on the next flush).
+    updateBarGraph(bandData);
+    drawBarGraph();
+    PROFILE_STAGE(PROFILE_BARGRAPH, stageStart);
 }
 
-void settingsMenuLoop()
+void startSpectrumAnalyzer()
 {
-    unsigned char temp;
-    SettingsMenuState menuState = INPUT_CHANNEL;
-    idleCounter = 0;
-    
-    // Update button states on global variables.
-    btnState_Action = digitalRead(SWITCH_ACTION);
-    btnState_Up = digitalRead(SWITCH_UP);
-    btnState_Down = digitalRead(SWITCH_DOWN);
-    btnState_Mute = digitalRead(SWITCH_MUTE);
-
-    lcd.clear();
-    lcd.print("Settings");
-    displayMenuItem(&menuState, &audioSettings, &audioOutMode);
-    
-    while(1)
+    // Spectrum analyzer is shown only in main screen while the output is not mute.
+    if((uiMode == UI_MODE_NORMAL) && (isAudioMute == FALSE))
     {
-        if((btnState_Action == LOW) && (digitalRead(SWITCH_ACTION) == HIGH))
-        {
-            // Action button press event.  
-            menuState = (menuState != EXIT) ? ((SettingsMenuState)(menuState + 1)) : INPUT_CHANNEL;
-            displayMenuItem(&menuState, &audioSettings, &audioOutMode);
+        // Bars start from the bottom, the screen may have been used by other content.
+        resetBarGraph();
 
-            idleCounter = 0;
-        }
-
-        if((btnState_Mute == LOW) && (digitalRead(SWITCH_MUTE) == HIGH))
-        {
-            // Mute audio in sound processor and the power amplifier.
-            isAudioMute = (audioSettings.switchConfig & SWITCH_MUTE_TDA8425) ? FALSE : TRUE;
+        startTask(taskAnalyzer);
+        startTask(taskAnalyzerRender);
+    }
+}
 
-            setPowerAmpMute(isAudioMute);
-            muteAudio(&audioSettings, isAudioMute);        
+void stopSpectrumAnalyzer()
+{
+    stopTask(taskAnalyzer);
+    stopTask(taskAnalyzerRender);
+}
 
-            idleCounter = 0; 
-            isLCDShowMute = TRUE;
+void registerUserActivity()
+{
+    // Stop spectrum analyzer and restart the idle timeout.
+    stopSpectrumAnalyzer();
+    startTask(taskIdle);
+}
 
-            delay(50);
-        }
+void toggleMute()
+{
+    // Mute audio in sound processor and the power amplifier (after the volume is ramped down).
+    isAudioMute = (isAudioMute == TRUE) ? FALSE : TRUE;
+    rampMute(&audioSettings, isAudioMute);
+}
 
-        if((btnState_Up == LOW) && (digitalRead(SWITCH_UP) == HIGH))
-        {
-            // Up button press event.
-            switch(menuState)
-            {
-                case INPUT_CHANNEL:
-                    // Rotate to next source selection mode ranging from 0x02 to 0x07.
-                    temp = audioSettings.switchConfig & 0x07;                                        
-                    temp = (temp >= 0x07) ? 0x02 : (temp + 1);
-                    audioSettings.switchConfig = (audioSettings.switchConfig & 0xF8) | temp;
-                    setSwitchConfiguration(&audioSettings);
-                    break;
-                case LVL_BASS:
-                    // Increase bass level and stop at the max level.
-                    audioSettings.bass = (audioSettings.bass < BASS_TDA8425_MAX) ? (audioSettings.bass + 1) : BASS_TDA8425_MAX;
-                    setBass(&audioSettings);
-                    break;
-                case LVL_TREBLE:
-                    // Increase treble level and stop and the max level.
-                    audioSettings.treble = (audioSettings.treble < TREBLE_TDA8425_MAX) ? (audioSettings.treble + 1) : TREBLE_TDA8425_MAX;
-                    setTreble(&audioSettings);
-                    break;
-                case MODE_STEREO:
-                    // Rotate to next channel mode ranging from 0x00 to 0x03.
-                    temp = (audioSettings.switchConfig & 0x18) >> 3;
-                    temp = (temp >= 0x03) ? 0x00 : (temp + 1);
-                    audioSettings.switchConfig = (audioSettings.switchConfig & 0xE7) | (temp << 3);
-                    setSwitchConfiguration(&audioSettings);
-                    break;
-                case OUTPUT_MODE:
-                    // Audio output mode (speaker or headphone selection).
-                    audioOutMode = (audioOutMode == AUDIO_OUT_SPEAKER) ? AUDIO_OUT_HEADPHONE : AUDIO_OUT_SPEAKER;
-                    setAudioOutputMode(audioOutMode);
-                    break;
-                case EXIT:
-                    // Save the changes and exit from the settings menu.
-                    saveConfiguration(&audioSettings, &audioOutMode);
-                    return;                    
-            }
+void updateMuteScreen()
+{
+    if(isAudioMute == TRUE)
+    {
+        // System is in mute state, and show MUTE on LCD.
+        stopSpectrumAnalyzer();
+        stopTask(taskIdle);
+        showMute();
+    }
+    else
+    {
+        startSpectrumAnalyzer();
+    }
+}
 
-            // Update display with new configuration / level.
-            displayMenuItem(&menuState, &audioSettings, &audioOutMode);
+void enterSettingsMenu()
+{
+    uiMode = UI_MODE_SETTINGS;
+    menuState = INPUT_CHANNEL;
 
-            idleCounter = 0;
-        }
+    stopSpectrumAnalyzer();
+    stopTask(taskIdle);
+    startTask(taskMenuTimeout);
 
-        if((btnState_Down == LOW) && (digitalRead(SWITCH_DOWN) == HIGH))
-        {
-            // Down button press event.
-            switch(menuState)
-            {
-                case INPUT_CHANNEL:
-                    // Rotate to next source selection mode ranging from 0x02 to 0x07.
-                    temp = audioSettings.switchConfig & 0x07;                                        
-                    temp = (temp == 0x02) ? 0x07 : (temp - 1);
-                    audioSettings.switchConfig = (audioSettings.switchConfig & 0xF8) | temp;
-                    setSwitchConfiguration(&audioSettings);
-                    break;
-                case LVL_BASS:
-                    // Increase bass level and stop at the min level.
-                    audioSettings.bass = (audioSettings.bass > BASS_TDA8425_MIN) ? (audioSettings.bass - 1) : BASS_TDA8425_MIN;
-                    setBass(&audioSettings);
-                    break;
-                case LVL_TREBLE:
-                    // Increase treble level and stop and the min level.
-                    audioSettings.treble = (audioSettings.treble > TREBLE_TDA8425_MIN) ? (audioSettings.treble - 1) : TREBLE_TDA8425_MIN;
-                    setTreble(&audioSettings);
-                    break;
-                case MODE_STEREO:
-                    // Rotate to next channel mode ranging from 0x00 to 0x03.
-                    temp = (audioSettings.switchConfig & 0x18) >> 3;
-                    temp = (temp == 0x00) ? 0x03 : (temp - 1);
-                    audioSettings.switchConfig = (audioSettings.switchConfig & 0xE7) | (temp << 3);
-                    setSwitchConfiguration(&audioSettings);
-                    break;
-                case OUTPUT_MODE:
-                    // Audio output mode (speaker or headphone selection).
-                    audioOutMode = (audioOutMode == AUDIO_OUT_SPEAKER) ? AUDIO_OUT_HEADPHONE : AUDIO_OUT_SPEAKER;
-                    setAudioOutputMode(audioOutMode);
-                    break;
-                case EXIT:
-                    // Save the changes and exit from the settings menu.
-                    saveConfiguration(&audioSettings, &audioOutMode);
-                    return;                    
-            }
+    frameBuffer.clear();
+    frameBuffer.print(F("Settings"));
+    displayMenuItem(&menuState, &audioSettings, &audioOutMode);
+}
 
-            // Update display with new configuration / level.
-            displayMenuItem(&menuState, &audioSettings, &audioOutMode);
+void exitSettingsMenu()
+{
+    // Save the settings (including a delayed save from before the menu) and return to the main 
+    // screen. Unchanged settings are not written by the configuration store.
+    stopTask(taskSaveConfig);
+    saveConfiguration(&audioSettings, &audioOutMode);
 
-            idleCounter = 0;
-        }  
-        
-        // Update button states.
-        btnState_Action = digitalRead(SWITCH_ACTION);
-        btnState_Up = digitalRead(SWITCH_UP);
-        btnState_Down = digitalRead(SWITCH_DOWN);  
-        btnState_Mute = digitalRead(SWITCH_MUTE);     
+    uiMode = UI_MODE_NORMAL;
+    stopTask(taskMenuTimeout);
 
-        // Check for idle timeout.
-        if(idleCounter >= IDLE_MENU_TIMEOUT)
-        {
-            // Idle timeout!, lets exit from the settings menu.
-            saveConfiguration(&audioSettings, &audioOutMode);
-            return;
-        }
-        else
-        {
-            // User is recently interacted with the system!
-            idleCounter++;
-            delay(50);             
-        }
+    if(isAudioMute == TRUE)
+    {
+        showMute();
+    }
+    else
+    {
+        startSpectrumAnalyzer();
     }
 }
 
-void setup() 
-{    
-    // Initialize Arduino libraries required for I2C and LCD.
-    lcd.begin(16, 2);
-    lcd.clear();
+#if ENABLE_PROFILER
+void enterDiagnostics()
+{
+    uiMode = UI_MODE_DIAGNOSTICS;
+    diagPage = 0;
 
-    Wire.begin(); 
-    
-    // Configure I/O pins.
-    pinMode(SWITCH_ACTION, INPUT_PULLUP);
-    pinMode(SWITCH_UP, INPUT_PULLUP);
-    pinMode(SWITCH_DOWN, INPUT_PULLUP);
-    pinMode(SWITCH_MUTE, INPUT_PULLUP);
-       
-    // Initialize TDA8425 audio processor (on I2C bus).
-    initSoundProcessor(&audioSettings);
+    // Analyzer keeps running to be profiled, the screen shows the statistics instead of the bars.
+    stopTask(taskAnalyzerRender);
+    stopTask(taskIdle);
+    startTask(taskAnalyzer);
+    startTask(taskDiagnostics);
 
-    // Setup global variables.
-    btnState_Action = digitalRead(SWITCH_ACTION);
-    btnState_Up = digitalRead(SWITCH_UP);
-    btnState_Down = digitalRead(SWITCH_DOWN);
-    btnState_Mute = digitalRead(SWITCH_MUTE);
+    displayDiagnostics(diagPage);
+}
 
-    audioOutMode  = AUDIO_OUT_SPEAKER;
-    idleCounter = IDLE_TIMEOUT;
-    isAudioMute = FALSE;
-    isLCDShowMute = FALSE;
+void exitDiagnostics()
+{
+    uiMode = UI_MODE_NORMAL;
+    stopTask(taskDiagnostics);
+    stopSpectrumAnalyzer();
+    updateMuteScreen();
+}
 
-    // Restore last audio configuration.
-    if(loadLastConfiguration(&audioSettings, &audioOutMode))
+void diagnosticsButtons(unsigned char isActionPress, unsigned char isUpPress, unsigned char isDownPress, unsigned char isMutePress)
+{
+    if(isActionPress)
     {
-        // Apply TDA8425 audio processor related configurations.
-        setVolume(&audioSettings);
-        setBass(&audioSettings);
-        setTreble(&audioSettings);
-        setSwitchConfiguration(&audioSettings);
+        exitDiagnostics();
+        return;
     }
 
-    // Release mute in TDA8425 audio processor and power amplifier.
-    muteAudio(&audioSettings, isAudioMute);
-    setPowerAmpMute(isAudioMute);
+    if(isMutePress)
+    {
+        // Restart the measurements.
+        resetProfiler();
+    }
 
-    // Activate last audio output.
-    setAudioOutputMode(audioOutMode);
+    if(isUpPress)
+    {
+        diagPage = (diagPage < (DIAGNOSTICS_PAGE_COUNT - 1)) ? (diagPage + 1) : 0;
+    }
 
-    // Define custom characters required for the spectrum analyzer.
-    lcd.createChar(1, graphLine1);
-    lcd.createChar(2, graphLine2);
-    lcd.createChar(3, graphLine3);
-    lcd.createChar(4, graphLine4);
-    lcd.createChar(5, graphLine5);
-    lcd.createChar(6, graphLine6);
-    lcd.createChar(7, graphLine7);
+    if(isDownPress)
+    {
+        diagPage = (diagPage > 0) ? (diagPage - 1) : (DIAGNOSTICS_PAGE_COUNT - 1);
+    }
+
+    displayDiagnostics(diagPage);
 }
+#endif
 
-void loop() 
+void settingsMenuButtons(unsigned char isActionPress, unsigned char isUpPress, unsigned char isDownPress, unsigned char isMutePress)
 {
-    if((btnState_Action == LOW) && (digitalRead(SWITCH_ACTION) == HIGH))
+    unsigned char temp;
+
+    if(isActionPress || isUpPress || isDownPress || isMutePress)
+    {
+        // User is recently interacted with the system!
+        startTask(taskMenuTimeout);
+    }
+
+    if(isActionPress)
     {
         // Action button press event.  
-        settingsMenuLoop();  
+        menuState = (menuState != EXIT) ? ((SettingsMenuState)(menuState + 1)) : INPUT_CHANNEL;
+        displayMenuItem(&menuState, &audioSettings, &audioOutMode);
+    }
+
+    if(isMutePress)
+    {
+        toggleMute();
+    }
 
-        // Wait until the exit button is released by the user.
-        while(!((digitalRead(SWITCH_UP) == HIGH) && (digitalRead(SWITCH_DOWN) == HIGH)))
+    if(isUpPress)
+    {
+        // Up button press event.
+        switch(menuState)
         {
-            delay(5);
+            case INPUT_CHANNEL:
+                // Rotate to next source selection mode ranging from 0x02 to 0x07.
+                temp = audioSettings.switchConfig & 0x07;                                        
+                temp = (temp >= 0x07) ? 0x02 : (temp + 1);
+                audioSettings.switchConfig = (audioSettings.switchConfig & 0xF8) | temp;
+                rampSwitchConfiguration(&audioSettings);
+                break;
+            case LVL_BASS:
+                // Increase bass level and stop at the max level.
+                audioSettings.bass = (audioSettings.bass < BASS_TDA8425_MAX) ? (audioSettings.bass + 1) : BASS_TDA8425_MAX;
+                setBass(&audioSettings);
+                break;
+            case LVL_TREBLE:
+                // Increase treble level and stop and the max level.
+                audioSettings.treble = (audioSettings.treble < TREBLE_TDA8425_MAX) ? (audioSettings.treble + 1) : TREBLE_TDA8425_MAX;
+                setTreble(&audioSettings);
+                break;
+            case MODE_STEREO:
+                // Rotate to next channel mode ranging from 0x00 to 0x03.
+                temp = (audioSettings.switchConfig & 0x18) >> 3;
+                temp = (temp >= 0x03) ? 0x00 : (temp + 1);
+                audioSettings.switchConfig = (audioSettings.switchConfig & 0xE7) | (temp << 3);
+                rampSwitchConfiguration(&audioSettings);
+                break;
+            case OUTPUT_MODE:
+                // Audio output mode (speaker or headphone selection).
+                audioOutMode = (audioOutMode == AUDIO_OUT_SPEAKER) ? AUDIO_OUT_HEADPHONE : AUDIO_OUT_SPEAKER;
+                setAudioOutputMode(audioOutMode);
+                break;
+            case EXIT:
+                // Save the changes and exit from the settings menu.
+                exitSettingsMenu();
+                return;                    
         }
 
-        // Update button state variables.
-        btnState_Action = digitalRead(SWITCH_ACTION);
-        btnState_Up = digitalRead(SWITCH_UP);
-        btnState_Down = digitalRead(SWITCH_DOWN);
-        btnState_Mute = digitalRead(SWITCH_MUTE);
-
-        idleCounter = IDLE_TIMEOUT;                    
+        // Update display with new configuration / level.
+        displayMenuItem(&menuState, &audioSettings, &audioOutMode);
     }
 
-    if((btnState_Mute == LOW) && (digitalRead(SWITCH_MUTE) == HIGH))
+    if(isDownPress)
     {
-        // Mute audio in sound processor and the power amplifier.
-        isAudioMute = (audioSettings.switchConfig & SWITCH_MUTE_TDA8425) ? FALSE : TRUE;
+        // Down button press event.
+        switch(menuState)
+        {
+            case INPUT_CHANNEL:
+                // Rotate to next source selection mode ranging from 0x02 to 0x07.
+                temp = audioSettings.switchConfig & 0x07;                                        
+                temp = (temp == 0x02) ? 0x07 : (temp - 1);
+                audioSettings.switchConfig = (audioSettings.switchConfig & 0xF8) | temp;
+                rampSwitchConfiguration(&audioSettings);
+                break;
+            case LVL_BASS:
+                // Increase bass level and stop at the min level.
+                audioSettings.bass = (audioSettings.bass > BASS_TDA8425_MIN) ? (audioSettings.bass - 1) : BASS_TDA8425_MIN;
+                setBass(&audioSettings);
+                break;
+            case LVL_TREBLE:
+                // Increase treble level and stop and the min level.
+                audioSettings.treble = (audioSettings.treble > TREBLE_TDA8425_MIN) ? (audioSettings.treble - 1) : TREBLE_TDA8425_MIN;
+                setTreble(&audioSettings);
+                break;
+            case MODE_STEREO:
+                // Rotate to next channel mode ranging from 0x00 to 0x03.
+                temp = (audioSettings.switchConfig & 0x18) >> 3;
+                temp = (temp == 0x00) ? 0x03 : (temp - 1);
+                audioSettings.switchConfig = (audioSettings.switchConfig & 0xE7) | (temp << 3);
+                rampSwitchConfiguration(&audioSettings);
+                break;
+            case OUTPUT_MODE:
+                // Audio output mode (speaker or headphone selection).
+                audioOutMode = (audioOutMode == AUDIO_OUT_SPEAKER) ? AUDIO_OUT_HEADPHONE : AUDIO_OUT_SPEAKER;
+                setAudioOutputMode(audioOutMode);
+                break;
+            case EXIT:
+                // Save the changes and exit from the settings menu.
+                exitSettingsMenu();
+                return;                    
+        }
 
-        setPowerAmpMute(isAudioMute);
-        muteAudio(&audioSettings, isAudioMute);     
+        // Update display with new configuration / level.
+        displayMenuItem(&menuState, &audioSettings, &audioOutMode);
+    }
+}
 
-        idleCounter = IDLE_TIMEOUT; 
-        isLCDShowMute = TRUE;
+void mainButtons(unsigned char isActionPress, unsigned char isUpPress, unsigned char isDownPress, unsigned char isMutePress)
+{
+    if(isActionPress)
+    {
+        // Action button press event.  
+        enterSettingsMenu();
+        return;
+    }
 
-        delay(50);
+    if(isMutePress)
+    {
+        toggleMute();
+        updateMuteScreen();
     }
 
     if(isAudioMute == FALSE)
     {        
         // Change volume only if the mute is released.
 
-        if((btnState_Up == LOW) && (digitalRead(SWITCH_UP) == HIGH))
+        if(isUpPress)
         {
             // Up button press event.        
             audioSettings.volume = (audioSettings.volume < VOLUME_TDA8425_MAX) ? (audioSettings.volume + 1) : audioSettings.volume;
-            setVolume(&audioSettings);
-            displayVolumeLevel(audioSettings.volume);
-            idleCounter = 0;        
+            rampVolume(&audioSettings);
         }
 
-        if((btnState_Down == LOW) && (digitalRead(SWITCH_DOWN) == HIGH))
+        if(isDownPress)
         {
             // Down button press event.
             audioSettings.volume = (audioSettings.volume > VOLUME_TDA8425_MIN) ? (audioSettings.volume - 1) : audioSettings.volume;
-            setVolume(&audioSettings);
-            displayVolumeLevel(audioSettings.volume);
-            idleCounter = 0;
+            rampVolume(&audioSettings);
         } 
     }
-    else
+    else if(isUpPress || isDownPress)
     {
-        // Check status of the volume up or down buttons.
-        if(((btnState_Up == LOW) && (digitalRead(SWITCH_UP) == HIGH)) || ((btnState_Down == LOW) && (digitalRead(SWITCH_DOWN) == HIGH)))
-        {
-            // Release mute if the volume button(s) are pressed.
-            isAudioMute = FALSE;
+        // Release mute if the volume button(s) are pressed.
+        isAudioMute = FALSE;
+        rampMute(&audioSettings, isAudioMute);
+    }
 
-            setPowerAmpMute(isAudioMute);
-            muteAudio(&audioSettings, isAudioMute);     
+    if(isUpPress || isDownPress)
+    {
+        // Show current volume level and save it once the user is done with the changes.
+        displayVolumeLevel(audioSettings.volume);
+        registerUserActivity();
+        startTask(taskSaveConfig);
+    }
+}
 
-            // Show current volume level.
-            displayVolumeLevel(audioSettings.volume);
-            idleCounter = 0; 
+void applyRemoteSettings(AudioSettings *newSettings, unsigned char newOutputMode, unsigned char newMute)
+{
+    unsigned char isSwitchChanged = (newSettings->switchConfig != audioSettings.switchConfig);
+    unsigned char isMuteChanged = (newMute != isAudioMute);
+    unsigned char isChanged = isMuteChanged || (newOutputMode != audioOutMode) || 
+        (memcmp(newSettings, &audioSettings, sizeof(AudioSettings)) != 0);
+
+    // Volume, tone and switch changes are applied together through the volume ramp.
+    audioSettings = *newSettings;
+    rampAudioSettings(&audioSettings, isSwitchChanged);
+
+    if(newOutputMode != audioOutMode)
+    {
+        audioOutMode = newOutputMode;
+        setAudioOutputMode(audioOutMode);
+    }
+
+    if(isMuteChanged)
+    {
+        isAudioMute = newMute;
+        rampMute(&audioSettings, isAudioMute);
+    }
+
+    if(uiMode == UI_MODE_SETTINGS)
+    {
+        // Changes are saved when the user leaves the settings menu.
+        displayMenuItem(&menuState, &audioSettings, &audioOutMode);
+        return;
+    }
 
-            isLCDShowMute = FALSE;
+    if(uiMode == UI_MODE_NORMAL)
+    {
+        if(isMuteChanged)
+        {
+            updateMuteScreen();
         }
-        
-        // System is in mute state, and show MUTE on LCD.
-        if(isLCDShowMute == TRUE)
+        else if(isTaskActive(taskIdle))
         {
-            isLCDShowMute = FALSE;
-            showMute();            
+            // Volume level is on the screen.
+            displayVolumeLevel(audioSettings.volume);
         }
-    }   
+    }
+
+    if(isChanged)
+    {
+        startTask(taskSaveConfig);
+    }
+}
 
-    // Update button states.
-    btnState_Action = digitalRead(SWITCH_ACTION);
-    btnState_Up = digitalRead(SWITCH_UP);
-    btnState_Down = digitalRead(SWITCH_DOWN);
-    btnState_Mute = digitalRead(SWITCH_MUTE);
+unsigned char setRemoteSettings(const unsigned char *payload, unsigned char length)
+{
+    AudioSettings newSettings = audioSettings;
+    unsigned char newOutputMode = audioOutMode;
+    unsigned char newMute = isAudioMute;
+    unsigned char pos, value;
 
-    // To minimize the write cycles, let save the current volume level at the middle 
-    // of timeout interval.
-    if(idleCounter == (IDLE_TIMEOUT / 2))
+    if((length == 0) || (length & 0x01))
     {
-        saveConfiguration(&audioSettings, &audioOutMode);
+        return REMOTE_STATUS_BAD_LENGTH;
     }
-    
-    // Place this code block at the bottom of the service loop.
-    if(isAudioMute == FALSE)
+
+    // Validate all the field and value pairs before applying any of them.
+    for(pos = 0; pos < length; pos += 2)
     {
-        // Idle detection is checked only if the output is not mute.
-        if(idleCounter >= IDLE_TIMEOUT)
+        value = payload[pos + 1];
+
+        switch(payload[pos])
+        {
+            case REMOTE_FIELD_VOLUME:
+                if(value > VOLUME_TDA8425_MAX)
+                {
+                    return REMOTE_STATUS_BAD_VALUE;
+                }
+                newSettings.volume = value;
+                break;
+            case REMOTE_FIELD_BASS:
+                if(value > BASS_TDA8425_MAX)
+                {
+                    return REMOTE_STATUS_BAD_VALUE;
+                }
+                newSettings.bass = value;
+                break;
+            case REMOTE_FIELD_TREBLE:
+                if(value > TREBLE_TDA8425_MAX)
+                {
+                    return REMOTE_STATUS_BAD_VALUE;
+                }
+                newSettings.treble = value;
+                break;
+            case REMOTE_FIELD_INPUT:
+                // Source selection mode ranging from 0x02 to 0x07.
+                if((value < 0x02) || (value > 0x07))
+                {
+                    return REMOTE_STATUS_BAD_VALUE;
+                }
+                newSettings.switchConfig = (newSettings.switchConfig & 0xF8) | value;
+                break;
+            case REMOTE_FIELD_STEREO:
+                // Channel mode ranging from 0x00 to 0x03.
+                if(value > 0x03)
+                {
+                    return REMOTE_STATUS_BAD_VALUE;
+                }
+                newSettings.switchConfig = (newSettings.switchConfig & 0xE7) | (value << 3);
+                break;
+            case REMOTE_FIELD_OUTPUT:
+                if(value > AUDIO_OUT_HEADPHONE)
+                {
+                    return REMOTE_STATUS_BAD_VALUE;
+                }
+                newOutputMode = value;
+                break;
+            case REMOTE_FIELD_MUTE:
+                if(value > 1)
+                {
+                    return REMOTE_STATUS_BAD_VALUE;
+                }
+                newMute = (value) ? TRUE : FALSE;
+                break;
+            default:
+                return REMOTE_STATUS_BAD_VALUE;
+        }
+    }
+
+    applyRemoteSettings(&newSettings, newOutputMode, newMute);
+    return REMOTE_STATUS_OK;
+}
+
+#if ENABLE_PROFILER
+unsigned char getRemoteProfile(const unsigned char *payload, unsigned char length, unsigned char *response, unsigned char *responseLength)
+{
+    ProfileStats stats;
+    unsigned short frameRate;
+
+    if(length != 1)
+    {
+        return REMOTE_STATUS_BAD_LENGTH;
+    }
+
+    if(payload[0] == REMOTE_PROFILE_SUMMARY)
+    {
+        // Number of stages, frame rates (in 0.1 fps), AGC gain and the last analyzer frame time (in us).
+        response[0] = PROFILE_STAGE_COUNT;
+        frameRate = getProfileFrameRate(PROFILE_ANALYZER_FRAME);
+        response[1] = frameRate & 0xFF;
+        response[2] = frameRate >> 8;
+        frameRate = getProfileFrameRate(PROFILE_RENDER_FRAME);
+        response[3] = frameRate & 0xFF;
+        response[4] = frameRate >> 8;
+        response[5] = (unsigned char)((signed char)getAutoGain());
+        response[6] = analyzerFrameTime & 0xFF;
+        response[7] = (analyzerFrameTime >> 8) & 0xFF;
+        *responseLength = 8;
+        return REMOTE_STATUS_OK;
+    }
+
+    if(payload[0] >= PROFILE_STAGE_COUNT)
+    {
+        return REMOTE_STATUS_BAD_VALUE;
+    }
+
+    // Minimum, average and maximum time of the stage (in Timer1 ticks) and the number of samples.
+    getProfileStats(payload[0], &stats);
+    response[0] = stats.minTicks & 0xFF;
+    response[1] = stats.minTicks >> 8;
+    response[2] = stats.avgTicks & 0xFF;
+    response[3] = stats.avgTicks >> 8;
+    response[4] = stats.maxTicks & 0xFF;
+    response[5] = stats.maxTicks >> 8;
+    response[6] = stats.count & 0xFF;
+    response[7] = stats.count >> 8;
+    *responseLength = 8;
+    return REMOTE_STATUS_OK;
+}
+#endif
+
+unsigned char onRemoteCommand(unsigned char command, const unsigned char *payload, unsigned char length, 
+    unsigned char *response, unsigned char *responseLength)
+{
+    switch(command)
+    {
+        case REMOTE_CMD_GET:
+            if(length != 0)
+            {
+                return REMOTE_STATUS_BAD_LENGTH;
+            }
+
+            // Values of all the fields in the field identifier order.
+            response[0] = audioSettings.volume;
+            response[1] = audioSettings.bass;
+            response[2] = audioSettings.treble;
+            response[3] = audioSettings.switchConfig & 0x07;
+            response[4] = (audioSettings.switchConfig & 0x18) >> 3;
+            response[5] = audioOutMode;
+            response[6] = (isAudioMute == TRUE) ? 1 : 0;
+            *responseLength = REMOTE_FIELD_COUNT;
+            return REMOTE_STATUS_OK;
+        case REMOTE_CMD_SET:
+            return setRemoteSettings(payload, length);
+        case REMOTE_CMD_STREAM:
+            // Enable (1) or disable (0) the analyzer frame stream.
+            if((length != 1) || (payload[0] > 1))
+            {
+                return (length != 1) ? REMOTE_STATUS_BAD_LENGTH : REMOTE_STATUS_BAD_VALUE;
+            }
+
+            setSpectrumStream(payload[0]);
+            return REMOTE_STATUS_OK;
+#if ENABLE_PROFILER
+        case REMOTE_CMD_PROFILE:
+            return getRemoteProfile(payload, length, response, responseLength);
+        case REMOTE_CMD_PROFILE_RESET:
+            resetProfiler();
+            return REMOTE_STATUS_OK;
+#endif
+    }
+
+    return REMOTE_STATUS_UNKNOWN_CMD;
+}
+
+void onButtonEvents()
+{
+    unsigned char event;
+    unsigned char isActionPress, isUpPress, isDownPress, isMutePress, isRepeat;
+
+    while((event = getButtonEvent()) != BUTTON_EVENT_NONE)
+    {
+        // Settings menu is opened on action button release, all the other buttons react on press. 
+        // Up and down buttons repeat the press while they are held down.
+        isRepeat = (BUTTON_EVENT_TYPE(event) == BUTTON_EVENT_REPEAT);
+        isActionPress = (event == (BUTTON_ACTION | BUTTON_EVENT_RELEASE));
+        isUpPress = (event == (BUTTON_UP | BUTTON_EVENT_PRESS)) || (event == (BUTTON_UP | BUTTON_EVENT_REPEAT));
+        isDownPress = (event == (BUTTON_DOWN | BUTTON_EVENT_PRESS)) || (event == (BUTTON_DOWN | BUTTON_EVENT_REPEAT));
+        isMutePress = (event == (BUTTON_MUTE | BUTTON_EVENT_PRESS));
+
+#if ENABLE_PROFILER
+        // Long press of the action button opens the diagnostics screen, and its release is ignored.
+        if(event == (BUTTON_ACTION | BUTTON_EVENT_LONG_PRESS))
+        {
+            isActionLongPress = TRUE;
+            if(uiMode == UI_MODE_NORMAL)
+            {
+                enterDiagnostics();
+            }
+        }
+
+        if(isActionPress && isActionLongPress)
         {
-            // System is in idle state (and display the spectrum analyzer).
-            updateSpectrumAnalyzer();
-            delay(5);
+            isActionLongPress = FALSE;
+            continue;
+        }
+
+        if(uiMode == UI_MODE_DIAGNOSTICS)
+        {
+            diagnosticsButtons(isActionPress, isUpPress, isDownPress, isMutePress);
+            continue;
+        }
+#endif
+
+        if(uiMode == UI_MODE_SETTINGS)
+        {
+            // Holding a button must not leave the settings menu.
+            if(isRepeat && (menuState == EXIT))
+            {
+                continue;
+            }
+
+            settingsMenuButtons(isActionPress, isUpPress, isDownPress, isMutePress);
         }
         else
         {
-            // User is recently interacted with the system!
-            idleCounter++;
-            delay(50);
+            mainButtons(isActionPress, isUpPress, isDownPress, isMutePress);
         }
     }
-    else
+
+    // Send modified characters to the LCD.
+    frameBuffer.flush();
+}
+
+void onAnalyzerFrame()
+{
+    updateSpectrumAnalyzer();
+}
+
+void onAnalyzerRender()
+{
+    renderSpectrumAnalyzer();
+
+    PROFILE_START(stageStart);
+    frameBuffer.flush();
+    PROFILE_STAGE(PROFILE_LCD, stageStart);
+    PROFILE_FRAME(PROFILE_RENDER_FRAME);
+}
+
+void onRemoteControl()
+{
+    pollRemoteProtocol();
+    frameBuffer.flush();
+}
+
+void onSaveConfiguration()
+{
+    // To minimize the write cycles, current settings are saved once the user is done with the changes.
+    saveConfiguration(&audioSettings, &audioOutMode);
+}
+
+void onIdleTimeout()
+{
+    // System is in idle state (and display the spectrum analyzer).
+    startSpectrumAnalyzer();
+}
+
+#if ENABLE_PROFILER
+void onDiagnosticsRefresh()
+{
+    displayDiagnostics(diagPage);
+    frameBuffer.flush();
+}
+#endif
+
+void onMenuTimeout()
+{
+    // Idle timeout!, lets exit from the settings menu.
+    exitSettingsMenu();
+    frameBuffer.flush();
+}
+
+void setup() 
+{    
+    // Initialize LCD and the I2C bus.
+    lcdInit();
+    frameBuffer.begin();
+
+    initI2CQueue();
+
+    // Start free-running audio sampler for the spectrum analyzer.
+    initAudioSampler(ANALYZER_ADC_PRESCALER);
+    
+    // Configure input buttons.
+    initButtons();
+       
+    // Initialize TDA8425 audio processor (on I2C bus).
+    initSoundProcessor(&audioSettings);
+
+    // Setup global variables.
+    audioOutMode  = AUDIO_OUT_SPEAKER;
+    isAudioMute = FALSE;
+    uiMode = UI_MODE_NORMAL;
+    menuState = INPUT_CHANNEL;
+
+    // Restore last audio configuration.
+    initEEPROMQueue();
+    initConfigStore();
+    if(loadLastConfiguration(&audioSettings, &audioOutMode))
     {
-        // System is in MUTE. 50ms delay is placed for button debouncing.
-        delay(50);
-    }    
-}
\ No newline at end of file
+        // Apply TDA8425 audio processor related configurations, output is kept muted until the 
+        // volume ramp starts.
+        audioSettings.switchConfig |= SWITCH_MUTE_TDA8425;
+        applyAudioSettings(&audioSettings);
+    }
+
+    // Release mute in TDA8425 audio processor and power amplifier, and ramp up the volume.
+    initVolumeRamp(&audioSettings);
+    rampMute(&audioSettings, isAudioMute);
+
+    // Activate last audio output.
+    setAudioOutputMode(audioOutMode);
+
+#if ENABLE_PROFILER
+    // Timer1 is used to measure the analyzer stages.
+    initProfiler();
+    isActionLongPress = FALSE;
+#endif
+
+    // Start listening to the remote control commands on the UART.
+    initRemoteProtocol(onRemoteCommand);
+
+    // Define custom characters required for the spectrum analyzer.
+    initBarGraph();
+    resetAutoGain();
+
+    // Create service tasks.
+    taskButtonEvents = createTask(onButtonEvents, BUTTON_EVENT_INTERVAL, TASK_PERIODIC);
+    taskAnalyzer = createTask(onAnalyzerFrame, ANALYZER_FRAME_INTERVAL, TASK_PERIODIC);
+    taskAnalyzerRender = createTask(onAnalyzerRender, ANALYZER_RENDER_INTERVAL, TASK_PERIODIC);
+    taskSaveConfig = createTask(onSaveConfiguration, SAVE_CONFIG_DELAY, TASK_ONE_SHOT);
+    taskIdle = createTask(onIdleTimeout, IDLE_TIMEOUT, TASK_ONE_SHOT);
+    taskMenuTimeout = createTask(onMenuTimeout, IDLE_MENU_TIMEOUT, TASK_ONE_SHOT);
+    taskRemote = createTask(onRemoteControl, REMOTE_POLL_INTERVAL, TASK_PERIODIC);
+#if ENABLE_PROFILER
+    taskDiagnostics = createTask(onDiagnosticsRefresh, DIAGNOSTICS_INTERVAL, TASK_PERIODIC);
+#endif
+
+    // Start with the spectrum analyzer on the main screen.
+    startTask(taskButtonEvents);
+    startTask(taskRemote);
+    startSpectrumAnalyzer();
+}
+
+void loop() 
+{
+    unsigned char isTaskExecuted;
+
+    PROFILE_START(loopStart);
+    isTaskExecuted = runScheduler();
+
+    // Reset a hung I2C bus, and resend the TDA8425 registers if the I2C queue was full or a 
+    // write failed on the last update.
+    serviceI2CQueue();
+    flushAudioProcRegisters();
+
+    // Post the settings record if the EEPROM write queue was full on the last save.
+    flushConfigStore();
+    PROFILE_STAGE(PROFILE_LOOP, loopStart);
+
+    // Sleep is outside of the profiled loop stage, so the stage measures only the work.
+    if(isTaskExecuted == FALSE)
+    {
+        idleScheduler();
+    }
+}
@@ -0,0 +1,121 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "profiler.h"
+#include "common.h"
+
+#if ENABLE_PROFILER
+
+#include <Arduino.h>
+
+typedef struct
+{
+    unsigned short minTicks;
+    unsigned short maxTicks;
+    unsigned long totalTicks;
+    unsigned short count;
+} ProfileStage;
+
+static ProfileStage stageList[PROFILE_STAGE_COUNT];
+static unsigned long frameCount[PROFILE_COUNTER_COUNT];
+static unsigned long resetTime;
+
+void initProfiler()
+{
+    // Free running Timer1 in normal mode with clk/8 prescaler.
+    TCCR1A = 0;
+    TCCR1B = _BV(CS11);
+    TIMSK1 = 0;
+
+    resetProfiler();
+}
+
+void resetProfiler()
+{
+    unsigned char pos;
+
+    for(pos = 0; pos < PROFILE_STAGE_COUNT; pos++)
+    {
+        stageList[pos].minTicks = 0xFFFF;
+        stageList[pos].maxTicks = 0;
+        stageList[pos].totalTicks = 0;
+        stageList[pos].count = 0;
+    }
+
+    for(pos = 0; pos < PROFILE_COUNTER_COUNT; pos++)
+    {
+        frameCount[pos] = 0;
+    }
+
+    resetTime = millis();
+}
+
+unsigned short recordProfileStage(unsigned char stage, unsigned short startTicks)
+{
+    unsigned short currentTicks = TCNT1;
+    unsigned short ticks = currentTicks - startTicks;
+    ProfileStage *stageStats = &stageList[stage];
+
+    stageStats->minTicks = (ticks < stageStats->minTicks) ? ticks : stageStats->minTicks;
+    stageStats->maxTicks = (ticks > stageStats->maxTicks) ? ticks : stageStats->maxTicks;
+
+    // Halve the accumulators before the counter overflows, average then follows the recent frames.
+    if(stageStats->count == 0xFFFF)
+    {
+        stageStats->totalTicks >>= 1;
+        stageStats->count >>= 1;
+    }
+
+    stageStats->totalTicks += ticks;
+    stageStats->count++;
+
+    // Time spent on recording is not added to the next stage.
+    return TCNT1;
+}
+
+void countProfileFrame(unsigned char counter)
+{
+    frameCount[counter]++;
+}
+
+void getProfileStats(unsigned char stage, ProfileStats *stats)
+{
+    ProfileStage *stageStats = &stageList[stage];
+
+    stats->count = stageStats->count;
+    stats->minTicks = (stageStats->count) ? stageStats->minTicks : 0;
+    stats->maxTicks = stageStats->maxTicks;
+    stats->avgTicks = (stageStats->count) ? (stageStats->totalTicks / stageStats->count) : 0;
+}
+
+unsigned short getProfileFrameRate(unsigned char counter)
+{
+    // Elapsed time in 0.1 seconds.
+    unsigned long elapsedTime = (millis() - resetTime) / 100;
+
+    return (elapsedTime) ? ((frameCount[counter] * 100UL) / elapsedTime) : 0;
+}
+
+#endif /* ENABLE_PROFILER */
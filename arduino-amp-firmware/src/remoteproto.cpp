@@ -0,0 +1,194 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "remoteproto.h"
+#include "common.h"
+#include "uart.h"
+
+#include <Arduino.h>
+#include <util/crc16.h>
+
+typedef enum
+{
+    WAIT_SYNC,
+    WAIT_LENGTH,
+    WAIT_COMMAND,
+    WAIT_REQUEST_ID,
+    WAIT_PAYLOAD,
+    WAIT_CRC
+
+} RemoteParserState;
+
+static RemoteCommandHandler commandHandler = NULL;
+
+// Frame which is being received.
+static RemoteParserState parserState;
+static unsigned char frameLength, frameCommand, frameRequestId, frameCRC;
+static unsigned char framePayload[REMOTE_MAX_REQUEST];
+static unsigned char payloadPos;
+static unsigned long lastByteTime;
+
+static void handleFrame()
+{
+    unsigned char response[REMOTE_MAX_REQUEST];
+    unsigned char responseLength = 0;
+
+    // Responses (e.g. an echo on a loop-back line) are never answered.
+    if(frameCommand & REMOTE_RESPONSE)
+    {
+        return;
+    }
+
+    if(frameCommand == REMOTE_CMD_PING)
+    {
+        response[0] = (frameLength == 0) ? REMOTE_STATUS_OK : REMOTE_STATUS_BAD_LENGTH;
+        response[1] = REMOTE_PROTOCOL_VERSION;
+        responseLength = 1;
+    }
+    else if(commandHandler != NULL)
+    {
+        response[0] = commandHandler(frameCommand, framePayload, frameLength, &response[1], &responseLength);
+    }
+    else
+    {
+        response[0] = REMOTE_STATUS_UNKNOWN_CMD;
+    }
+
+    // Error responses carry only the status code.
+    responseLength = (response[0] == REMOTE_STATUS_OK) ? (responseLength + 1) : 1;
+
+    // Response is dropped if the transmit buffer is full, host retries after a timeout.
+    sendRemoteFrame(frameCommand | REMOTE_RESPONSE, frameRequestId, response, responseLength);
+}
+
+static void parseByte(unsigned char data)
+{
+    switch(parserState)
+    {
+        case WAIT_SYNC:
+            if(data == REMOTE_SYNC)
+            {
+                parserState = WAIT_LENGTH;
+            }
+            return;
+        case WAIT_LENGTH:
+            if(data > REMOTE_MAX_REQUEST)
+            {
+                // Not a valid frame, look for the next sync byte.
+                parserState = (data == REMOTE_SYNC) ? WAIT_LENGTH : WAIT_SYNC;
+                return;
+            }
+
+            frameLength = data;
+            frameCRC = _crc8_ccitt_update(0, data);
+            parserState = WAIT_COMMAND;
+            return;
+        case WAIT_COMMAND:
+            frameCommand = data;
+            frameCRC = _crc8_ccitt_update(frameCRC, data);
+            parserState = WAIT_REQUEST_ID;
+            return;
+        case WAIT_REQUEST_ID:
+            frameRequestId = data;
+            frameCRC = _crc8_ccitt_update(frameCRC, data);
+            payloadPos = 0;
+            parserState = (frameLength == 0) ? WAIT_CRC : WAIT_PAYLOAD;
+            return;
+        case WAIT_PAYLOAD:
+            framePayload[payloadPos++] = data;
+            frameCRC = _crc8_ccitt_update(frameCRC, data);
+            parserState = (payloadPos == frameLength) ? WAIT_CRC : WAIT_PAYLOAD;
+            return;
+        case WAIT_CRC:
+            parserState = WAIT_SYNC;
+            if(data == frameCRC)
+            {
+                handleFrame();
+            }
+            return;
+    }
+}
+
+void initRemoteProtocol(RemoteCommandHandler handler)
+{
+    commandHandler = handler;
+    parserState = WAIT_SYNC;
+    lastByteTime = millis();
+
+    initUART();
+}
+
+void pollRemoteProtocol()
+{
+    unsigned char data;
+    unsigned long currentTime = millis();
+
+    // Resynchronize if the sender stopped in the middle of a frame.
+    if((parserState != WAIT_SYNC) && ((currentTime - lastByteTime) > REMOTE_FRAME_TIMEOUT))
+    {
+        parserState = WAIT_SYNC;
+    }
+
+    // Receive buffer limits the work done in a single call.
+    while(uartRead(&data))
+    {
+        lastByteTime = currentTime;
+        parseByte(data);
+    }
+}
+
+unsigned char sendRemoteFrame(unsigned char command, unsigned char requestId, const unsigned char *payload, unsigned char length)
+{
+    unsigned char header[4];
+    unsigned char pos, crc;
+
+    // Frame is queued only as a whole, so a partially sent frame never breaks the stream. Free 
+    // space can only grow between the writes (the UART ISR drains the buffer).
+    if((length > REMOTE_MAX_PAYLOAD) || (getUARTTxFree() < (length + REMOTE_FRAME_OVERHEAD)))
+    {
+        return FALSE;
+    }
+
+    header[0] = REMOTE_SYNC;
+    header[1] = length;
+    header[2] = command;
+    header[3] = requestId;
+
+    crc = 0;
+    for(pos = 1; pos < 4; pos++)
+    {
+        crc = _crc8_ccitt_update(crc, header[pos]);
+    }
+
+    for(pos = 0; pos < length; pos++)
+    {
+        crc = _crc8_ccitt_update(crc, payload[pos]);
+    }
+
+    uartWrite(header, 4);
+    uartWrite(payload, length);
+    uartWrite(&crc, 1);
+    return TRUE;
+}
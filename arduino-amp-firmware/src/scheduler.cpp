@@ -0,0 +1,126 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "scheduler.h"
+#include "common.h"
+
+#include <Arduino.h>
+#include <avr/sleep.h>
+
+typedef struct
+{
+    TaskCallback callback;
+    unsigned long nextRun;
+    unsigned short interval;
+    unsigned char mode;
+    unsigned char isActive;
+} SchedulerTask;
+
+static SchedulerTask taskList[SCHEDULER_MAX_TASKS];
+static unsigned char taskCount = 0;
+
+unsigned char createTask(TaskCallback callback, unsigned short interval, unsigned char mode)
+{
+    if(taskCount >= SCHEDULER_MAX_TASKS)
+    {
+        // Task table is full.
+        return TASK_INVALID;
+    }
+
+    taskList[taskCount].callback = callback;
+    taskList[taskCount].interval = interval;
+    taskList[taskCount].mode = mode;
+    taskList[taskCount].isActive = FALSE;
+
+    return taskCount++;
+}
+
+void startTask(unsigned char taskId)
+{
+    if(taskId < taskCount)
+    {
+        // (Re)start the task, first run is after one interval from now.
+        taskList[taskId].nextRun = millis() + taskList[taskId].interval;
+        taskList[taskId].isActive = TRUE;
+    }
+}
+
+void stopTask(unsigned char taskId)
+{
+    if(taskId < taskCount)
+    {
+        taskList[taskId].isActive = FALSE;
+    }
+}
+
+unsigned char isTaskActive(unsigned char taskId)
+{
+    return (taskId < taskCount) ? taskList[taskId].isActive : FALSE;
+}
+
+unsigned char runScheduler()
+{
+    unsigned char taskId;
+    unsigned char isTaskExecuted = FALSE;
+    unsigned long timeNow;
+    SchedulerTask *task;
+
+    for(taskId = 0; taskId < taskCount; taskId++)
+    {
+        task = &taskList[taskId];
+        timeNow = millis();
+
+        // Signed difference keeps the comparison valid across millis() overflow.
+        if((task->isActive) && ((long)(timeNow - task->nextRun) >= 0))
+        {
+            if(task->mode == TASK_ONE_SHOT)
+            {
+                // Deactivate before the callback, so the callback can restart it.
+                task->isActive = FALSE;
+            }
+            else
+            {
+                task->nextRun += task->interval;
+
+                // Skip the missed periods instead of running the task back-to-back.
+                if((long)(timeNow - task->nextRun) >= 0)
+                {
+                    task->nextRun = timeNow + task->interval;
+                }
+            }
+
+            task->callback();
+            isTaskExecuted = TRUE;
+        }
+    }
+
+    return isTaskExecuted;
+}
+
+void idleScheduler()
+{
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_mode();
+}
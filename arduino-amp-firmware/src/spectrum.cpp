@@ -0,0 +1,124 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "spectrum.h"
+#include "common.h"
+
+#include "fftq15.h"
+#include "q15math.h"
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+// Fractional part of log2(1 + i/16) in Q4 format.
+static const unsigned char log2FracTable[16] PROGMEM = 
+{
+    0, 1, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 15
+};
+
+unsigned short estimateMagnitude(long real, long img)
+{
+    unsigned long maxValue, minValue, magnitude;
+
+    real = (real < 0) ? -real : real;
+    img = (img < 0) ? -img : img;
+
+    maxValue = (real > img) ? real : img;
+    minValue = (real > img) ? img : real;
+
+    // Alpha max plus beta min approximation of sqrt(real^2 + img^2), max(max, 7/8.max + 1/2.min) 
+    // with the peak error of about 4%.
+    magnitude = maxValue - (maxValue >> 3) + (minValue >> 1);
+    magnitude = (magnitude > maxValue) ? magnitude : maxValue;
+
+    // Keep the headroom for summing adjacent bins.
+    return (magnitude > SPECTRUM_MAX_MAGNITUDE) ? SPECTRUM_MAX_MAGNITUDE : magnitude;
+}
+
+unsigned char getLog2Q4(unsigned short value)
+{
+    unsigned char msbPos = 15;
+
+    if(value == 0)
+    {
+        return 0;
+    }
+
+    // Locate the most significant bit, and use the next 4 bits as mantissa.
+    while((value & 0x8000) == 0)
+    {
+        value <<= 1;
+        msbPos--;
+    }
+
+    return (msbPos << 4) + pgm_read_byte(&log2FracTable[(value >> 11) & 0x0F]);
+}
+
+unsigned char magnitudeToLevel(unsigned short magnitude)
+{
+    unsigned char logValue = getLog2Q4(magnitude);
+
+    // Map the magnitude to the display levels in equal dB steps (1 unit of log2 Q4 = 0.376dB).
+    if(logValue <= SPECTRUM_LEVEL_FLOOR)
+    {
+        return 0;
+    }
+
+    logValue = (logValue - SPECTRUM_LEVEL_FLOOR) / SPECTRUM_LEVEL_STEP;
+    return (logValue > SPECTRUM_MAX_LEVEL) ? SPECTRUM_MAX_LEVEL : logValue;
+}
+
+void computeSpectrum(short *samples, unsigned short *magnitude)
+{
+    unsigned char k, mirror;
+    short evenReal, evenImg, oddReal, oddImg;
+    short cosValue, sinValue;
+    long outReal, outImg;
+    short *fftReal = samples;
+    short *fftImg = samples + SPECTRUM_FFT_POINTS;
+
+    // ADC sampler stores even samples in the first half and odd samples in the second half of 
+    // the frame, so they are the real and imaginary parts of a half-size complex FFT.
+    fftQ15(fftReal, fftImg, SPECTRUM_FFT_ORDER);
+
+    // Separate the spectra of even (E) and odd (O) samples and combine them into the spectrum of 
+    // the real input: X[k] = E[k] + W^k.O[k].
+    for(k = 0; k < SPECTRUM_FFT_POINTS; k++)
+    {
+        mirror = (SPECTRUM_FFT_POINTS - k) & (SPECTRUM_FFT_POINTS - 1);
+
+        evenReal = (fftReal[k] >> 1) + (fftReal[mirror] >> 1);
+        evenImg = (fftImg[k] >> 1) - (fftImg[mirror] >> 1);
+        oddReal = (fftImg[k] >> 1) + (fftImg[mirror] >> 1);
+        oddImg = (fftReal[mirror] >> 1) - (fftReal[k] >> 1);
+
+        getTwiddle(k * (FFT_ANGLE_HALF_CIRCLE / SPECTRUM_FFT_POINTS), &cosValue, &sinValue);
+
+        outReal = (long)evenReal + mulQ15(cosValue, oddReal) + mulQ15(sinValue, oddImg);
+        outImg = (long)evenImg + mulQ15(cosValue, oddImg) - mulQ15(sinValue, oddReal);
+
+        magnitude[k] = estimateMagnitude(outReal, outImg);
+    }
+}
@@ -0,0 +1,142 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "spectrumstream.h"
+#include "common.h"
+#include "remoteproto.h"
+#include "uart.h"
+
+#include <Arduino.h>
+#include <string.h>
+
+#define KEYFRAME_SIZE   (SPECTRUM_STREAM_HEADER_SIZE + (ANALYZER_COLUMNS * 2))
+
+static unsigned char isStreamEnabled = FALSE;
+static unsigned char frameSequence, framesToKey, droppedFrames;
+
+// Band magnitudes of the last sent frame (reference of the delta frames).
+static unsigned short lastBands[ANALYZER_COLUMNS];
+
+void setSpectrumStream(unsigned char isEnabled)
+{
+    isStreamEnabled = (isEnabled) ? TRUE : FALSE;
+
+    // Stream always starts with a keyframe.
+    framesToKey = 0;
+    droppedFrames = 0;
+}
+
+unsigned char isSpectrumStreamEnabled()
+{
+    return isStreamEnabled;
+}
+
+static unsigned char encodeKeyframe(const unsigned short *bands, unsigned char *payload)
+{
+    unsigned char band, pos = SPECTRUM_STREAM_HEADER_SIZE;
+
+    for(band = 0; band < ANALYZER_COLUMNS; band++)
+    {
+        payload[pos++] = bands[band] & 0xFF;
+        payload[pos++] = bands[band] >> 8;
+    }
+
+    return pos;
+}
+
+static unsigned char encodeDeltaFrame(const unsigned short *bands, unsigned char *payload)
+{
+    unsigned char band, pos = SPECTRUM_STREAM_HEADER_SIZE;
+    unsigned short delta;
+
+    for(band = 0; band < ANALYZER_COLUMNS; band++)
+    {
+        // Zigzag maps small positive and negative differences to small codes.
+        delta = bands[band] - lastBands[band];
+        delta = (delta << 1) ^ ((delta & 0x8000) ? 0xFFFF : 0x0000);
+
+        while(delta >= 0x80)
+        {
+            payload[pos++] = (delta & 0x7F) | 0x80;
+            delta >>= 7;
+        }
+
+        payload[pos++] = delta;
+
+        // Fall back to a keyframe if the differences do not compress.
+        if(pos > (KEYFRAME_SIZE - 3))
+        {
+            return 0;
+        }
+    }
+
+    return pos;
+}
+
+void streamSpectrumFrame(const unsigned short *bands, short gain)
+{
+    unsigned char payload[KEYFRAME_SIZE];
+    unsigned char length = 0;
+    unsigned short timestamp;
+
+    if(isStreamEnabled == FALSE)
+    {
+        return;
+    }
+
+    // Drop the frame without encoding it if the host is not keeping up.
+    if(getUARTTxFree() < (KEYFRAME_SIZE + REMOTE_FRAME_OVERHEAD))
+    {
+        droppedFrames = (droppedFrames < 0xFF) ? (droppedFrames + 1) : droppedFrames;
+        return;
+    }
+
+    if(framesToKey != 0)
+    {
+        length = encodeDeltaFrame(bands, payload);
+    }
+
+    payload[0] = 0;
+    if(length == 0)
+    {
+        length = encodeKeyframe(bands, payload);
+        payload[0] = SPECTRUM_STREAM_KEYFRAME;
+        framesToKey = SPECTRUM_STREAM_KEYFRAME_INTERVAL;
+    }
+
+    timestamp = millis();
+    payload[1] = timestamp & 0xFF;
+    payload[2] = timestamp >> 8;
+    payload[3] = (unsigned char)((signed char)gain);
+    payload[4] = droppedFrames;
+
+    // Free space is already checked, so the frame is always queued.
+    sendRemoteFrame(REMOTE_FRAME_SPECTRUM, frameSequence, payload, length);
+
+    memcpy(lastBands, bands, sizeof(lastBands));
+    frameSequence++;
+    framesToKey--;
+    droppedFrames = 0;
+}
@@ -25,58 +25,226 @@
 
 #include "tda8425.h"
 #include "common.h"
+#include "i2cqueue.h"
 
 #include <Arduino.h>
-#include <Wire.h>
+#include <util/atomic.h>
 
 #define TDA8425_ADDRESS 0x41
 
-void sendAudioProcCommand(unsigned char subAddr, unsigned char value)
+// Shadow register file indexes. Volume, bass and treble registers have consecutive sub-addresses 
+// (0x00 - 0x03) and are written in a single auto-increment burst, switch register is at 0x08.
+#define REG_VOLUME_LEFT     0x00
+#define REG_VOLUME_RIGHT    0x01
+#define REG_BASS            0x02
+#define REG_TREBLE          0x03
+#define REG_SWITCH          0x04
+
+#define REG_COUNT           5
+#define REG_BURST_COUNT     4
+
+#define REG_ALL_MASK        0x1F
+
+// Requested register values and the values which are already sent to the TDA8425.
+static unsigned char regValue[REG_COUNT];
+static unsigned char regShadow[REG_COUNT];
+
+// Shadow registers with a known value (bit per register).
+static volatile unsigned char regValidMask;
+
+// Last commit did not fit into the I2C queue, or a write failed on the bus.
+static volatile unsigned char isCommitPending;
+
+static void onAudioProcError(unsigned char address, unsigned char subAddr, unsigned char status)
+{
+    // Content of the TDA8425 is unknown after a failed write, resend everything on next commit.
+    if(address == TDA8425_ADDRESS)
+    {
+        regValidMask = 0;
+        isCommitPending = TRUE;
+    }
+}
+
+static unsigned char sendRegisterBurst(unsigned char firstReg, unsigned char lastReg)
+{
+    unsigned char regPos;
+
+    if(i2cWrite(TDA8425_ADDRESS, firstReg, &regValue[firstReg], (lastReg - firstReg) + 1) != I2C_STATUS_OK)
+    {
+        return FALSE;
+    }
+
+    for(regPos = firstReg; regPos <= lastReg; regPos++)
+    {
+        regShadow[regPos] = regValue[regPos];
+    }
+
+    return TRUE;
+}
+
+static unsigned char sendSwitchRegister()
+{
+    if(sendAudioProcCommand(SUBCMD_TDA8425_SWITCH, regValue[REG_SWITCH]) != I2C_STATUS_OK)
+    {
+        return FALSE;
+    }
+
+    regShadow[REG_SWITCH] = regValue[REG_SWITCH];
+    return TRUE;
+}
+
+static void commitAudioProcRegisters()
+{
+    unsigned char regPos, firstReg, lastReg, validMask;
+    unsigned char isSwitchDirty, isMuting, isSent;
+
+    // Failed write (reported by the TWI interrupt) clears the valid mask and requests a new commit.
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        validMask = regValidMask;
+        regValidMask = REG_ALL_MASK;
+        isCommitPending = FALSE;
+    }
+
+    firstReg = REG_COUNT;
+    lastReg = 0;
+
+    // Find the range of modified volume, bass and treble registers.
+    for(regPos = 0; regPos < REG_BURST_COUNT; regPos++)
+    {
+        if(((validMask & _BV(regPos)) == 0) || (regValue[regPos] != regShadow[regPos]))
+        {
+            firstReg = (firstReg == REG_COUNT) ? regPos : firstReg;
+            lastReg = regPos;
+        }
+    }
+
+    isSwitchDirty = ((validMask & _BV(REG_SWITCH)) == 0) || (regValue[REG_SWITCH] != regShadow[REG_SWITCH]);
+    isMuting = (regValue[REG_SWITCH] & SWITCH_MUTE_TDA8425) ? TRUE : FALSE;
+
+    // Apply mute before changing the levels, and release it after the levels are updated. The 
+    // commit stops at the first write which does not fit into the I2C queue, so the order is kept.
+    isSent = TRUE;
+
+    if(isSwitchDirty && isMuting)
+    {
+        isSent = sendSwitchRegister();
+    }
+
+    if(isSent && (firstReg != REG_COUNT))
+    {
+        isSent = sendRegisterBurst(firstReg, lastReg);
+    }
+
+    if(isSent && isSwitchDirty && (!isMuting))
+    {
+        isSent = sendSwitchRegister();
+    }
+
+    if(isSent == FALSE)
+    {
+        // Unsent registers stay dirty (and unknown ones stay invalid) for the next commit.
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            regValidMask &= validMask;
+        }
+
+        isCommitPending = TRUE;
+    }
+}
+
+static void stageAudioSettings(AudioSettings *audioSettings)
+{
+    regValue[REG_VOLUME_LEFT] = audioSettings->volume | 0xC0;
+    regValue[REG_VOLUME_RIGHT] = audioSettings->volume | 0xC0;
+    regValue[REG_BASS] = audioSettings->bass | 0xF0;
+    regValue[REG_TREBLE] = audioSettings->treble | 0xF0;
+    regValue[REG_SWITCH] = audioSettings->switchConfig;
+}
+
+unsigned char sendAudioProcCommand(unsigned char subAddr, unsigned char value)
 {
-    Wire.beginTransmission(TDA8425_ADDRESS);
-    Wire.write(subAddr);
-    Wire.write(value);
-    Wire.endTransmission();
+    // Write is queued and sent by the TWI interrupt in the background.
+    return i2cWrite(TDA8425_ADDRESS, subAddr, &value, 1);
+}
+
+void flushAudioProcRegisters()
+{
+    if(isCommitPending)
+    {
+        commitAudioProcRegisters();
+    }
 }
 
 void initSoundProcessor(AudioSettings *audioSettings)
 {
     // Mute audio and enable linear stereo.
     audioSettings->switchConfig = (SWITCH_MUTE_TDA8425 | SWITCH_LINEAR_STEREO_TDA8425 | SWITCH_STEREO_TWO_CHANNEL | 0xC0);
-    sendAudioProcCommand(SUBCMD_TDA8425_SWITCH, audioSettings->switchConfig);
     
     // Set volume level to minimum position (-80dB).
     audioSettings->volume = VOLUME_TDA8425_MIN;
-    sendAudioProcCommand(SUBCMD_TDA8425_VOLUME_LEFT, (VOLUME_TDA8425_MIN | 0xC0));
-    sendAudioProcCommand(SUBCMD_TDA8425_VOLUME_RIGHT, (VOLUME_TDA8425_MIN | 0xC0));
 
     // Set bass and treble levels to 0dB.
     audioSettings->bass = 0x06;
-    sendAudioProcCommand(SUBCMD_TDA8425_BASS, (0x06 | 0xF0));
-    
     audioSettings->treble = 0x06;
-    sendAudioProcCommand(SUBCMD_TDA8425_TREBLE, (0x06 | 0xF0));    
+
+    // Register content is unknown after power-up, write all the registers.
+    regValidMask = 0;
+    isCommitPending = FALSE;
+    setI2CCallbacks(NULL, onAudioProcError);
+
+    stageAudioSettings(audioSettings);
+    commitAudioProcRegisters();
 }
 
-void setVolume(AudioSettings *audioSettings)
+void applyAudioSettings(AudioSettings *audioSettings)
 {
     audioSettings->volume = (audioSettings->volume > VOLUME_TDA8425_MAX) ? VOLUME_TDA8425_MAX : audioSettings->volume;
+    audioSettings->bass = (audioSettings->bass > BASS_TDA8425_MAX) ? BASS_TDA8425_MAX : audioSettings->bass;
+    audioSettings->treble = (audioSettings->treble > TREBLE_TDA8425_MAX) ? TREBLE_TDA8425_MAX : audioSettings->treble;
 
-    // Set volume on both left and right channels.
-    sendAudioProcCommand(SUBCMD_TDA8425_VOLUME_LEFT, (audioSettings->volume | 0xC0));
-    sendAudioProcCommand(SUBCMD_TDA8425_VOLUME_RIGHT, (audioSettings->volume | 0xC0));
+    // Only the modified registers are sent to the TDA8425.
+    stageAudioSettings(audioSettings);
+    commitAudioProcRegisters();
+}
+
+void applyAudioSettingsAtLevel(AudioSettings *audioSettings, unsigned char level)
+{
+    audioSettings->bass = (audioSettings->bass > BASS_TDA8425_MAX) ? BASS_TDA8425_MAX : audioSettings->bass;
+    audioSettings->treble = (audioSettings->treble > TREBLE_TDA8425_MAX) ? TREBLE_TDA8425_MAX : audioSettings->treble;
+    level = (level > VOLUME_TDA8425_MAX) ? VOLUME_TDA8425_MAX : level;
+
+    // Tone and switch settings are sent in one commit, volume registers are kept at the given 
+    // level (used by the volume ramp).
+    stageAudioSettings(audioSettings);
+    regValue[REG_VOLUME_LEFT] = level | 0xC0;
+    regValue[REG_VOLUME_RIGHT] = level | 0xC0;
+    commitAudioProcRegisters();
+}
+
+void setVolumeLevel(unsigned char level)
+{
+    // Set both channels to the given level without changing the volume setting (used by the 
+    // volume ramp).
+    level = (level > VOLUME_TDA8425_MAX) ? VOLUME_TDA8425_MAX : level;
+
+    regValue[REG_VOLUME_LEFT] = level | 0xC0;
+    regValue[REG_VOLUME_RIGHT] = level | 0xC0;
+    commitAudioProcRegisters();
 }
 
 void setBass(AudioSettings *audioSettings)
 {
     audioSettings->bass = (audioSettings->bass > BASS_TDA8425_MAX) ? BASS_TDA8425_MAX : audioSettings->bass;
-    sendAudioProcCommand(SUBCMD_TDA8425_BASS, (audioSettings->bass | 0xF0));
+    regValue[REG_BASS] = audioSettings->bass | 0xF0;
+    commitAudioProcRegisters();
 }
 
 void setTreble(AudioSettings *audioSettings)
 {
     audioSettings->treble = (audioSettings->treble > TREBLE_TDA8425_MAX) ? TREBLE_TDA8425_MAX : audioSettings->treble;
-    sendAudioProcCommand(SUBCMD_TDA8425_TREBLE, (audioSettings->treble | 0xF0));
+    regValue[REG_TREBLE] = audioSettings->treble | 0xF0;
+    commitAudioProcRegisters();
 }
 
 void muteAudio(AudioSettings *audioSettings, unsigned char isMute)
@@ -90,10 +258,6 @@ void muteAudio(AudioSettings *audioSettings, unsigned char isMute)
         audioSettings->switchConfig = audioSettings->switchConfig & (~SWITCH_MUTE_TDA8425);
     }
 
-    sendAudioProcCommand(SUBCMD_TDA8425_SWITCH, audioSettings->switchConfig);
-}
-
-void setSwitchConfiguration(AudioSettings *audioSettings)
-{
-    sendAudioProcCommand(SUBCMD_TDA8425_SWITCH, audioSettings->switchConfig);
+    regValue[REG_SWITCH] = audioSettings->switchConfig;
+    commitAudioProcRegisters();
 }
@@ -0,0 +1,143 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "uart.h"
+#include "common.h"
+
+#include <Arduino.h>
+#include <util/atomic.h>
+
+// Goertzel filters run in the ADC ISR for each sample with the interrupts disabled.
+#if (ANALYZER_ENGINE == ANALYZER_ENGINE_GOERTZEL_ISR) && (UART_RX_MAX_LATENCY < 1500)
+#error "UART baud rate is too high for the Goertzel ISR engine, received bytes would be lost"
+#endif
+
+#define UART_RX_NEXT(pos)   (((pos) + 1) & (UART_RX_BUFFER_SIZE - 1))
+#define UART_TX_NEXT(pos)   (((pos) + 1) & (UART_TX_BUFFER_SIZE - 1))
+
+static unsigned char rxBuffer[UART_RX_BUFFER_SIZE];
+static volatile unsigned char rxHead, rxTail;
+static volatile unsigned char rxErrors;
+
+static unsigned char txBuffer[UART_TX_BUFFER_SIZE];
+static volatile unsigned char txHead, txTail;
+
+void initUART()
+{
+    rxHead = 0;
+    rxTail = 0;
+    rxErrors = 0;
+    txHead = 0;
+    txTail = 0;
+
+    // Double speed mode gives lower baud rate error at the standard baud rates.
+    UCSR0A = _BV(U2X0);
+    UBRR0 = ((F_CPU / 4 / UART_BAUD_RATE) - 1) / 2;
+
+    // 8 data bits, no parity and 1 stop bit.
+    UCSR0C = _BV(UCSZ01) | _BV(UCSZ00);
+    UCSR0B = _BV(RXEN0) | _BV(TXEN0) | _BV(RXCIE0);
+}
+
+unsigned char uartRead(unsigned char *data)
+{
+    unsigned char pos = rxTail;
+
+    if(pos == rxHead)
+    {
+        return FALSE;
+    }
+
+    *data = rxBuffer[pos];
+    rxTail = UART_RX_NEXT(pos);
+    return TRUE;
+}
+
+unsigned char uartWrite(const unsigned char *data, unsigned char length)
+{
+    unsigned char pos, dataPos;
+
+    if(length > getUARTTxFree())
+    {
+        return FALSE;
+    }
+
+    // Only the main context writes to the head, ISR only moves the tail.
+    pos = txHead;
+    for(dataPos = 0; dataPos < length; dataPos++)
+    {
+        txBuffer[pos] = data[dataPos];
+        pos = UART_TX_NEXT(pos);
+    }
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        txHead = pos;
+        UCSR0B |= _BV(UDRIE0);
+    }
+
+    return TRUE;
+}
+
+unsigned char getUARTTxFree()
+{
+    // One entry is kept free to separate the full and the empty buffer.
+    return (txTail - txHead - 1) & (UART_TX_BUFFER_SIZE - 1);
+}
+
+unsigned char getUARTRxErrors()
+{
+    return rxErrors;
+}
+
+ISR(USART_RX_vect)
+{
+    unsigned char status = UCSR0A;
+    unsigned char data = UDR0;
+    unsigned char nextHead = UART_RX_NEXT(rxHead);
+
+    // Corrupted bytes are dropped, the protocol layer recovers with the frame CRC.
+    if((status & (_BV(FE0) | _BV(DOR0))) || (nextHead == rxTail))
+    {
+        rxErrors++;
+        return;
+    }
+
+    rxBuffer[rxHead] = data;
+    rxHead = nextHead;
+}
+
+ISR(USART_UDRE_vect)
+{
+    if(txTail == txHead)
+    {
+        // Nothing left to send.
+        UCSR0B &= ~_BV(UDRIE0);
+        return;
+    }
+
+    UDR0 = txBuffer[txTail];
+    txTail = UART_TX_NEXT(txTail);
+}
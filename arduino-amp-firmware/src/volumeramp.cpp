@@ -0,0 +1,169 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "volumeramp.h"
+#include "common.h"
+#include "tda8425.h"
+#include "yda138.h"
+#include "scheduler.h"
+
+#include <Arduino.h>
+
+// Changes applied at the bottom of the ramp.
+#define RAMP_ACTION_MUTE    0x01
+#define RAMP_ACTION_UNMUTE  0x02
+#define RAMP_ACTION_SWITCH  0x04
+
+static AudioSettings *rampSettings;
+static unsigned char taskVolumeRamp = TASK_INVALID;
+
+// Volume level in the TDA8425 registers, requested mute state and the pending changes.
+static unsigned char currentLevel;
+static unsigned char isMuted;
+static unsigned char pendingActions;
+
+static void onVolumeRampTick()
+{
+    unsigned char targetLevel;
+
+    // Output is ramped down to apply the pending changes, and stays down while muted.
+    targetLevel = ((pendingActions != 0) || isMuted) ? VOLUME_TDA8425_MIN : rampSettings->volume;
+
+    if(currentLevel != targetLevel)
+    {
+        currentLevel = (currentLevel < targetLevel) ? (currentLevel + 1) : (currentLevel - 1);
+        setVolumeLevel(currentLevel);
+        return;
+    }
+
+    if(pendingActions != 0)
+    {
+        // Output is silent, apply the switch changes and ramp in on the next ticks.
+        if(pendingActions & RAMP_ACTION_MUTE)
+        {
+            muteAudio(rampSettings, TRUE);
+            setPowerAmpMute(TRUE);
+        }
+
+        if(pendingActions & RAMP_ACTION_SWITCH)
+        {
+            applyAudioSettingsAtLevel(rampSettings, currentLevel);
+        }
+
+        if(pendingActions & RAMP_ACTION_UNMUTE)
+        {
+            setPowerAmpMute(FALSE);
+            muteAudio(rampSettings, FALSE);
+        }
+
+        pendingActions = 0;
+        return;
+    }
+
+    // Target is reached.
+    stopTask(taskVolumeRamp);
+}
+
+static void startVolumeRamp()
+{
+    // Keep the step interval if the ramp is already running.
+    if(isTaskActive(taskVolumeRamp) == FALSE)
+    {
+        startTask(taskVolumeRamp);
+    }
+}
+
+void initVolumeRamp(AudioSettings *audioSettings)
+{
+    rampSettings = audioSettings;
+    pendingActions = 0;
+    isMuted = (audioSettings->switchConfig & SWITCH_MUTE_TDA8425) ? TRUE : FALSE;
+
+    // Start from the lowest level, volume is ramped in once the output is unmuted.
+    currentLevel = VOLUME_TDA8425_MIN;
+    setVolumeLevel(currentLevel);
+
+    if(taskVolumeRamp == TASK_INVALID)
+    {
+        taskVolumeRamp = createTask(onVolumeRampTick, VOLUME_RAMP_INTERVAL, TASK_PERIODIC);
+    }
+}
+
+void rampVolume(AudioSettings *audioSettings)
+{
+    audioSettings->volume = (audioSettings->volume > VOLUME_TDA8425_MAX) ? VOLUME_TDA8425_MAX : audioSettings->volume;
+
+    rampSettings = audioSettings;
+    startVolumeRamp();
+}
+
+void rampMute(AudioSettings *audioSettings, unsigned char isMute)
+{
+    rampSettings = audioSettings;
+    isMuted = isMute;
+
+    // Latest request replaces the opposite one if it is not applied yet.
+    if(isMute)
+    {
+        pendingActions = (pendingActions & (~RAMP_ACTION_UNMUTE)) | RAMP_ACTION_MUTE;
+    }
+    else
+    {
+        pendingActions = (pendingActions & (~RAMP_ACTION_MUTE)) | RAMP_ACTION_UNMUTE;
+    }
+
+    startVolumeRamp();
+}
+
+void rampSwitchConfiguration(AudioSettings *audioSettings)
+{
+    rampSettings = audioSettings;
+    pendingActions |= RAMP_ACTION_SWITCH;
+    startVolumeRamp();
+}
+
+void rampAudioSettings(AudioSettings *audioSettings, unsigned char isSwitchChanged)
+{
+    audioSettings->volume = (audioSettings->volume > VOLUME_TDA8425_MAX) ? VOLUME_TDA8425_MAX : audioSettings->volume;
+
+    rampSettings = audioSettings;
+    if(isSwitchChanged)
+    {
+        pendingActions |= RAMP_ACTION_SWITCH;
+    }
+
+    // Without a pending switch change the tone is applied right away at the current ramp level.
+    if((pendingActions & RAMP_ACTION_SWITCH) == 0)
+    {
+        applyAudioSettingsAtLevel(audioSettings, currentLevel);
+    }
+
+    startVolumeRamp();
+}
+
+unsigned char isVolumeRampIdle()
+{
+    return (isTaskActive(taskVolumeRamp)) ? FALSE : TRUE;
+}
@@ -0,0 +1,147 @@
+/*************************************************************************
+  This file is part of the Arduino Mini Amplifier project.
+
+  Copyright (c) 2025 Dilshan R Jayakody [jayakody2000lk at gmail d0t com]
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Software, and to
+  permit persons to whom the Software is furnished to do so, subject to
+  the following conditions:
+  
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+  
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*************************************************************************/
+
+#include "window.h"
+#include "common.h"
+
+#include <avr/pgmspace.h>
+
+// Window coefficients in Q15 format, w[n] for n = 0 .. N/2 (generated for the periodic form).
+
+#if (ANALYZER_WINDOW == WINDOW_HANN) && (ANALYZER_SAMPLES == 128)
+
+const short windowTable[WINDOW_TABLE_SIZE] PROGMEM =
+{
+    0, 20, 79, 177, 315, 491, 705, 958,
+    1247, 1573, 1935, 2331, 2761, 3224, 3719, 4244,
+    4799, 5381, 5990, 6624, 7281, 7961, 8660, 9379,
+    10114, 10864, 11628, 12403, 13187, 13980, 14778, 15580,
+    16383, 17187, 17989, 18787, 19580, 20364, 21139, 21903,
+    22653, 23388, 24107, 24806, 25486, 26143, 26777, 27386,
+    27968, 28523, 29048, 29543, 30006, 30436, 30832, 31194,
+    31520, 31809, 32062, 32276, 32452, 32590, 32688, 32747,
+    32767
+};
+
+#elif (ANALYZER_WINDOW == WINDOW_HAMMING) && (ANALYZER_SAMPLES == 128)
+
+const short windowTable[WINDOW_TABLE_SIZE] PROGMEM =
+{
+    2621, 2640, 2694, 2785, 2911, 3073, 3270, 3502,
+    3769, 4069, 4401, 4766, 5162, 5588, 6043, 6526,
+    7036, 7572, 8132, 8715, 9320, 9945, 10589, 11250,
+    11926, 12616, 13319, 14032, 14754, 15483, 16217, 16955,
+    17694, 18434, 19172, 19906, 20635, 21357, 22070, 22772,
+    23462, 24139, 24799, 25443, 26068, 26673, 27256, 27816,
+    28352, 28862, 29346, 29801, 30227, 30623, 30987, 31320,
+    31620, 31886, 32118, 32315, 32477, 32604, 32694, 32749,
+    32767
+};
+
+#elif (ANALYZER_WINDOW == WINDOW_BLACKMAN) && (ANALYZER_SAMPLES == 128)
+
+const short windowTable[WINDOW_TABLE_SIZE] PROGMEM =
+{
+    0, 7, 29, 64, 115, 181, 264, 363,
+    479, 615, 770, 945, 1143, 1364, 1609, 1880,
+    2177, 2503, 2857, 3242, 3657, 4104, 4583, 5094,
+    5639, 6216, 6827, 7469, 8144, 8850, 9585, 10350,
+    11141, 11957, 12797, 13658, 14537, 15431, 16338, 17255,
+    18178, 19104, 20029, 20949, 21861, 22761, 23644, 24508,
+    25347, 26158, 26938, 27682, 28388, 29050, 29667, 30236,
+    30752, 31214, 31620, 31966, 32253, 32477, 32638, 32735,
+    32767
+};
+
+#elif (ANALYZER_WINDOW == WINDOW_HANN) && (ANALYZER_SAMPLES == 256)
+
+const short windowTable[WINDOW_TABLE_SIZE] PROGMEM =
+{
+    0, 5, 20, 44, 79, 123, 177, 241,
+    315, 398, 491, 593, 705, 827, 958, 1098,
+    1247, 1406, 1573, 1749, 1935, 2128, 2331, 2542,
+    2761, 2989, 3224, 3468, 3719, 3978, 4244, 4518,
+    4799, 5086, 5381, 5682, 5990, 6304, 6624, 6950,
+    7281, 7618, 7961, 8308, 8660, 9017, 9379, 9744,
+    10114, 10487, 10864, 11244, 11628, 12014, 12403, 12794,
+    13187, 13583, 13980, 14378, 14778, 15178, 15580, 15981,
+    16383, 16786, 17187, 17589, 17989, 18389, 18787, 19184,
+    19580, 19973, 20364, 20753, 21139, 21523, 21903, 22280,
+    22653, 23023, 23388, 23750, 24107, 24459, 24806, 25149,
+    25486, 25817, 26143, 26463, 26777, 27085, 27386, 27681,
+    27968, 28249, 28523, 28789, 29048, 29299, 29543, 29778,
+    30006, 30225, 30436, 30639, 30832, 31018, 31194, 31361,
+    31520, 31669, 31809, 31940, 32062, 32174, 32276, 32369,
+    32452, 32526, 32590, 32644, 32688, 32723, 32747, 32762,
+    32767
+};
+
+#elif (ANALYZER_WINDOW == WINDOW_HAMMING) && (ANALYZER_SAMPLES == 256)
+
+const short windowTable[WINDOW_TABLE_SIZE] PROGMEM =
+{
+    2621, 2626, 2640, 2662, 2694, 2735, 2785, 2843,
+    2911, 2988, 3073, 3167, 3270, 3382, 3502, 3631,
+    3769, 3914, 4069, 4231, 4401, 4580, 4766, 4960,
+    5162, 5371, 5588, 5812, 6043, 6281, 6526, 6778,
+    7036, 7301, 7572, 7849, 8132, 8421, 8715, 9015,
+    9320, 9630, 9945, 10265, 10589, 10917, 11250, 11586,
+    11926, 12270, 12616, 12966, 13319, 13674, 14032, 14392,
+    14754, 15117, 15483, 15849, 16217, 16585, 16955, 17324,
+    17694, 18064, 18434, 18803, 19172, 19539, 19906, 20271,
+    20635, 20997, 21357, 21714, 22070, 22422, 22772, 23119,
+    23462, 23802, 24139, 24471, 24799, 25124, 25443, 25758,
+    26068, 26373, 26673, 26967, 27256, 27539, 27816, 28088,
+    28352, 28611, 28862, 29107, 29346, 29577, 29801, 30017,
+    30227, 30429, 30623, 30809, 30987, 31158, 31320, 31474,
+    31620, 31757, 31886, 32006, 32118, 32221, 32315, 32401,
+    32477, 32545, 32604, 32654, 32694, 32726, 32749, 32762,
+    32767
+};
+
+#elif (ANALYZER_WINDOW == WINDOW_BLACKMAN) && (ANALYZER_SAMPLES == 256)
+
+const short windowTable[WINDOW_TABLE_SIZE] PROGMEM =
+{
+    0, 2, 7, 16, 29, 45, 64, 88,
+    115, 146, 181, 221, 264, 311, 363, 419,
+    479, 545, 615, 690, 770, 855, 945, 1041,
+    1143, 1250, 1364, 1483, 1609, 1741, 1880, 2025,
+    2177, 2336, 2503, 2676, 2857, 3046, 3242, 3445,
+    3657, 3876, 4104, 4339, 4583, 4834, 5094, 5362,
+    5639, 5924, 6216, 6517, 6827, 7144, 7469, 7803,
+    8144, 8493, 8850, 9214, 9585, 9964, 10350, 10742,
+    11141, 11546, 11957, 12374, 12797, 13225, 13658, 14095,
+    14537, 14982, 15431, 15883, 16338, 16796, 17255, 17716,
+    18178, 18641, 19104, 19567, 20029, 20490, 20949, 21406,
+    21861, 22313, 22761, 23205, 23644, 24079, 24508, 24931,
+    25347, 25756, 26158, 26553, 26938, 27315, 27682, 28040,
+    28388, 28725, 29050, 29365, 29667, 29958, 30236, 30500,
+    30752, 30990, 31214, 31424, 31620, 31801, 31966, 32117,
+    32253, 32373, 32477, 32565, 32638, 32694, 32735, 32759,
+    32767
+};
+
+#endif
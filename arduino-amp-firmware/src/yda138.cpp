@@ -25,15 +25,16 @@
 
 #include "yda138.h"
 #include "common.h"
+#include "fastpin.h"
 
 #include <Arduino.h>
 
 void setPowerAmpMute(unsigned char isMute)
 {
-    digitalWrite(YDA138_MUTE_CNT, (isMute) ? HIGH : LOW);
+    FastPin<YDA138_MUTE_CNT>::write(isMute);
 }
 
 void setAudioOutputMode(unsigned char mode)
 {
-    digitalWrite(YDA138_HEADPHONE_MODE, (mode == AUDIO_OUT_SPEAKER) ? HIGH : LOW);
+    FastPin<YDA138_HEADPHONE_MODE>::write(mode == AUDIO_OUT_SPEAKER);
 }
\ No newline at end of file
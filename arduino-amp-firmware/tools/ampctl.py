@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+# Command line control of the amplifier over the UART control protocol.
+#
+#   ampctl.py -p /dev/ttyUSB0 ping
+#   ampctl.py -p /dev/ttyUSB0 get
+#   ampctl.py -p /dev/ttyUSB0 set volume=40 bass=8 treble=7
+#   ampctl.py -p /dev/ttyUSB0 profile [--reset]
+#
+# Fields of a single set command are applied by the amplifier in one update. Use fakeamp.py to
+# try the tool without the hardware.
+
+import argparse
+import os
+import sys
+
+import ampproto
+
+
+def parse_assignments(items):
+    settings = {}
+    for item in items:
+        name, sep, value = item.partition("=")
+        if not sep or name not in ampproto.FIELDS:
+            raise argparse.ArgumentTypeError("expected <field>=<value>, fields: %s" % ", ".join(ampproto.FIELDS))
+
+        value = int(value, 0)
+        if not 0 <= value <= ampproto.FIELDS[name][1]:
+            raise argparse.ArgumentTypeError("%s is out of range (0 - %d)" % (name, ampproto.FIELDS[name][1]))
+
+        settings[name] = value
+    return settings
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Arduino mini amplifier remote control.")
+    parser.add_argument("-p", "--port", required=True, help="serial device of the amplifier")
+    parser.add_argument("-b", "--baud", type=int, default=ampproto.BAUD_RATE)
+    parser.add_argument("-t", "--timeout", type=float, default=0.3, help="response timeout in seconds")
+
+    commands = parser.add_subparsers(dest="command", required=True)
+    commands.add_parser("ping", help="check the connection and print the protocol version")
+    commands.add_parser("get", help="print the current settings")
+    set_parser = commands.add_parser("set", help="change one or more settings together")
+    set_parser.add_argument("assignments", nargs="+", metavar="field=value")
+    profile_parser = commands.add_parser("profile", help="print the analyzer profiler statistics (profiler firmware)")
+    profile_parser.add_argument("--reset", action="store_true", help="restart the measurements after printing")
+
+    args = parser.parse_args()
+
+    try:
+        settings = parse_assignments(args.assignments) if args.command == "set" else None
+    except (argparse.ArgumentTypeError, ValueError) as error:
+        parser.error(str(error))
+
+    fd = ampproto.open_port(args.port, args.baud)
+    try:
+        amp = ampproto.Amplifier(fd, timeout=args.timeout)
+
+        if args.command == "ping":
+            print("protocol version %d" % amp.ping())
+        elif args.command == "get":
+            for name, value in amp.get().items():
+                print("%s=%d" % (name, value))
+        elif args.command == "profile":
+            summary, stages = amp.profile()
+            print("analyzer %.1f fps, render %.1f fps, agc gain %d, last frame %d us" %
+                  (summary["analyzer_fps"], summary["render_fps"], summary["agc_gain"], summary["frame_time_us"]))
+            print("%-10s %10s %10s %10s %8s" % ("stage", "min", "avg", "max", "count"))
+            for name, stats in stages.items():
+                print("%-10s %10d %10d %10d %8d" % (name, stats["min"], stats["avg"], stats["max"], stats["count"]))
+            print("(cycles at 16MHz, 16 cycles per microsecond)")
+
+            if args.reset:
+                amp.reset_profile()
+        else:
+            amp.set(**settings)
+    except ampproto.ProtocolError as error:
+        print("error: %s" % error, file=sys.stderr)
+        return 1
+    finally:
+        os.close(fd)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,350 @@
+# Host side of the binary UART control protocol of the amplifier (see include/remoteproto.h).
+#
+# Frame: SYNC | LEN | CMD | REQID | PAYLOAD (LEN bytes) | CRC8, where CRC8 (polynomial 0x07,
+# initial value 0) covers LEN, CMD, REQID and the payload.
+
+import os
+import select
+import struct
+import termios
+import time
+
+SYNC = 0xA5
+MAX_PAYLOAD = 40
+RESPONSE = 0x80
+BAUD_RATE = 500000
+
+CMD_PING = 0x01
+CMD_GET = 0x02
+CMD_SET = 0x03
+CMD_STREAM = 0x04
+CMD_PROFILE = 0x05
+CMD_PROFILE_RESET = 0x06
+
+# Profiler (firmware built with ENABLE_PROFILER), stage names in the firmware order.
+PROFILE_SUMMARY = 0xFF
+PROFILE_STAGES = ("capture", "transform", "bands", "stream", "agc", "levels", "bargraph", "lcd", "loop")
+PROFILE_CYCLES_PER_TICK = 8
+
+# Frames sent by the device without a request.
+FRAME_SPECTRUM = RESPONSE | 0x40
+
+# Setting fields in the order of the GET response: name -> (identifier, max value).
+FIELDS = {
+    "volume": (0x01, 0x3F),
+    "bass": (0x02, 0x0F),
+    "treble": (0x03, 0x0F),
+    "input": (0x04, 0x07),
+    "stereo": (0x05, 0x03),
+    "output": (0x06, 0x01),
+    "mute": (0x07, 0x01),
+}
+
+STATUS_OK = 0x00
+STATUS_NAMES = {
+    0x00: "ok",
+    0x01: "unknown command",
+    0x02: "bad length",
+    0x03: "bad value",
+}
+
+PROTOCOL_VERSION = 0x01
+
+
+class ProtocolError(Exception):
+    pass
+
+
+def crc8(data, crc=0):
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def encode_frame(command, request_id, payload=b""):
+    if len(payload) > MAX_PAYLOAD:
+        raise ProtocolError("payload is too long (%d bytes)" % len(payload))
+
+    body = bytes([len(payload), command, request_id]) + bytes(payload)
+    return bytes([SYNC]) + body + bytes([crc8(body)])
+
+
+class FrameParser:
+    """Incremental frame parser, mirrors the parser state machine of the firmware."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.crc_errors = 0
+
+    def feed(self, data):
+        """Add received bytes and return the list of complete (command, request_id, payload) frames."""
+        self.buffer.extend(data)
+        frames = []
+
+        while True:
+            start = self.buffer.find(bytes([SYNC]))
+            if start < 0:
+                self.buffer.clear()
+                break
+
+            del self.buffer[:start]
+            if len(self.buffer) < 2:
+                break
+
+            length = self.buffer[1]
+            if length > MAX_PAYLOAD:
+                del self.buffer[:1]
+                continue
+
+            if len(self.buffer) < length + 5:
+                break
+
+            body = bytes(self.buffer[1:length + 4])
+            if crc8(body) == self.buffer[length + 4]:
+                frames.append((body[1], body[2], body[3:]))
+                del self.buffer[:length + 5]
+            else:
+                # Sync byte may be a part of the payload, look for the next one.
+                self.crc_errors += 1
+                del self.buffer[:1]
+
+        return frames
+
+
+def open_port(path, baud=BAUD_RATE):
+    """Open a serial device (or a pty) in raw mode without any extra dependencies."""
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+
+    attrs = termios.tcgetattr(fd)
+    attrs[0] = 0
+    attrs[1] = 0
+    attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+    attrs[3] = 0
+    speed = getattr(termios, "B%d" % baud)
+    attrs[4] = speed
+    attrs[5] = speed
+    attrs[6][termios.VMIN] = 0
+    attrs[6][termios.VTIME] = 0
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    termios.tcflush(fd, termios.TCIOFLUSH)
+    return fd
+
+
+def read_frames(fd, parser, timeout):
+    """Wait up to the timeout (in seconds) for at least one frame."""
+    deadline = time.monotonic() + timeout
+
+    while True:
+        remaining = deadline - time.monotonic()
+        if remaining <= 0:
+            return []
+
+        ready, _, _ = select.select([fd], [], [], remaining)
+        if not ready:
+            return []
+
+        try:
+            data = os.read(fd, 256)
+        except BlockingIOError:
+            continue
+
+        frames = parser.feed(data)
+        if frames:
+            return frames
+
+
+class Amplifier:
+    """Request / response client with request identifiers and retries."""
+
+    def __init__(self, fd, timeout=0.3, retries=3):
+        self.fd = fd
+        self.timeout = timeout
+        self.retries = retries
+        self.parser = FrameParser()
+        self.request_id = 0
+        self.pending = []
+
+    def request(self, command, payload=b""):
+        self.request_id = (self.request_id + 1) & 0xFF
+        frame = encode_frame(command, self.request_id, payload)
+
+        for _ in range(self.retries):
+            os.write(self.fd, frame)
+            deadline = time.monotonic() + self.timeout
+
+            while time.monotonic() < deadline:
+                for resp_command, resp_id, resp_payload in read_frames(self.fd, self.parser, deadline - time.monotonic()):
+                    # Stale responses of the earlier attempts are skipped, unsolicited frames are kept.
+                    if resp_command == FRAME_SPECTRUM:
+                        self.pending.append((resp_command, resp_id, resp_payload))
+                        continue
+
+                    if resp_command != (command | RESPONSE) or resp_id != self.request_id:
+                        continue
+
+                    if not resp_payload:
+                        raise ProtocolError("empty response")
+
+                    if resp_payload[0] != STATUS_OK:
+                        raise ProtocolError(STATUS_NAMES.get(resp_payload[0], "status 0x%02X" % resp_payload[0]))
+
+                    return resp_payload[1:]
+
+        raise ProtocolError("no response from the device")
+
+    def discard_frames(self):
+        """Frames received while waiting for a response (e.g. spectrum frames)."""
+        frames, self.pending = self.pending, []
+        return frames
+
+    def ping(self):
+        return self.request(CMD_PING)[0]
+
+    def get(self):
+        values = self.request(CMD_GET)
+        return dict(zip(FIELDS.keys(), values))
+
+    def set(self, **settings):
+        """Set one or more fields, the device applies all of them together or none."""
+        payload = bytearray()
+        for name, value in settings.items():
+            if name not in FIELDS:
+                raise ProtocolError("unknown field: %s" % name)
+            payload += bytes([FIELDS[name][0], value])
+
+        self.request(CMD_SET, bytes(payload))
+
+    def stream(self, enable):
+        self.request(CMD_STREAM, bytes([1 if enable else 0]))
+
+    def profile(self):
+        """Return the profiler summary and the cycle statistics of each stage."""
+        stage_count, analyzer_fps, render_fps, gain, frame_time = struct.unpack("<BHHbH", self.request(CMD_PROFILE, bytes([PROFILE_SUMMARY])))
+        summary = {"analyzer_fps": analyzer_fps / 10.0, "render_fps": render_fps / 10.0, "agc_gain": gain, "frame_time_us": frame_time}
+
+        stages = {}
+        for stage in range(stage_count):
+            min_ticks, avg_ticks, max_ticks, count = struct.unpack("<HHHH", self.request(CMD_PROFILE, bytes([stage])))
+            name = PROFILE_STAGES[stage] if stage < len(PROFILE_STAGES) else "stage%d" % stage
+            stages[name] = {
+                "min": min_ticks * PROFILE_CYCLES_PER_TICK,
+                "avg": avg_ticks * PROFILE_CYCLES_PER_TICK,
+                "max": max_ticks * PROFILE_CYCLES_PER_TICK,
+                "count": count,
+            }
+
+        return summary, stages
+
+    def reset_profile(self):
+        self.request(CMD_PROFILE_RESET)
+
+
+# Spectrum stream frames (see include/spectrumstream.h):
+# FLAGS | TIMESTAMP (16-bit, ms) | GAIN (signed) | DROPPED | BANDS
+SPECTRUM_KEYFRAME = 0x01
+SPECTRUM_HEADER = struct.Struct("<BHbB")
+
+
+def zigzag_encode(delta):
+    delta &= 0xFFFF
+    return ((delta << 1) ^ (0xFFFF if delta & 0x8000 else 0)) & 0xFFFF
+
+
+def zigzag_decode(code):
+    return (code >> 1) ^ (0xFFFF if code & 1 else 0)
+
+
+class SpectrumEncoder:
+    """Encoder of the spectrum frames, mirrors src/spectrumstream.cpp (used by the fake device)."""
+
+    def __init__(self, keyframe_interval=32):
+        self.keyframe_interval = keyframe_interval
+        self.sequence = 0
+        self.frames_to_key = 0
+        self.last_bands = None
+
+    def encode(self, bands, timestamp, gain, dropped=0):
+        flags = 0
+        data = b""
+
+        if self.frames_to_key and self.last_bands is not None:
+            data = bytearray()
+            for band, last in zip(bands, self.last_bands):
+                code = zigzag_encode(band - last)
+                while code >= 0x80:
+                    data.append((code & 0x7F) | 0x80)
+                    code >>= 7
+                data.append(code)
+
+            # Keyframe is smaller if the differences do not compress.
+            if len(data) > (len(bands) * 2) - 3:
+                data = b""
+
+        if not data:
+            flags = SPECTRUM_KEYFRAME
+            data = struct.pack("<%dH" % len(bands), *bands)
+            self.frames_to_key = self.keyframe_interval
+
+        payload = SPECTRUM_HEADER.pack(flags, timestamp & 0xFFFF, gain, dropped) + bytes(data)
+        frame = encode_frame(FRAME_SPECTRUM, self.sequence, payload)
+
+        self.last_bands = list(bands)
+        self.sequence = (self.sequence + 1) & 0xFF
+        self.frames_to_key -= 1
+        return frame
+
+
+class SpectrumDecoder:
+    """Decoder of the spectrum frames, delta frames are skipped until the next keyframe after a lost frame."""
+
+    def __init__(self):
+        self.bands = None
+        self.sequence = None
+        self.timestamp = None
+        self.lost_frames = 0
+        self.dropped_frames = 0
+
+    def decode(self, sequence, payload):
+        """Return (time_ms, gain, dropped, bands) or None if the frame can not be decoded."""
+        if len(payload) < SPECTRUM_HEADER.size:
+            return None
+
+        flags, timestamp, gain, dropped = SPECTRUM_HEADER.unpack_from(payload)
+        data = payload[SPECTRUM_HEADER.size:]
+
+        # Frames lost on the line (e.g. CRC errors) break the delta chain.
+        if self.sequence is not None and sequence != ((self.sequence + 1) & 0xFF):
+            self.lost_frames += (sequence - self.sequence - 1) & 0xFF
+            self.bands = None
+        self.sequence = sequence
+
+        if flags & SPECTRUM_KEYFRAME:
+            self.bands = list(struct.unpack("<%dH" % (len(data) // 2), data))
+        elif self.bands is not None:
+            codes = []
+            code = shift = 0
+            for byte in data:
+                code |= (byte & 0x7F) << shift
+                shift += 7
+                if not byte & 0x80:
+                    codes.append(code)
+                    code = shift = 0
+
+            if len(codes) != len(self.bands):
+                self.bands = None
+                return None
+
+            self.bands = [(band + zigzag_decode(code)) & 0xFFFF for band, code in zip(self.bands, codes)]
+        else:
+            return None
+
+        # Extend the 16-bit device timestamp.
+        if self.timestamp is None:
+            self.timestamp = timestamp
+        else:
+            self.timestamp += (timestamp - self.timestamp) & 0xFFFF
+
+        self.dropped_frames += dropped
+        return self.timestamp, gain, dropped, list(self.bands)
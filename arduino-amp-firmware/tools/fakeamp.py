@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+# Fake amplifier on a pseudo terminal, answers the UART control protocol like the firmware.
+# Prints the pty path to use with ampctl.py, e.g.:
+#
+#   ./fakeamp.py &
+#   ./ampctl.py -p /dev/pts/5 set volume=40 mute=0
+#
+# While the spectrum stream is enabled, synthetic analyzer frames are sent at FRAME_RATE.
+
+import math
+import os
+import random
+import select
+import struct
+import sys
+import time
+import tty
+
+import ampproto
+
+LIMITS = {ident: (name, limit) for name, (ident, limit) in ampproto.FIELDS.items()}
+
+FRAME_RATE = 150
+COLUMNS = 16
+
+
+class FakeAmplifier:
+    def __init__(self):
+        # Defaults of the firmware after the first power up.
+        self.settings = {"volume": 0, "bass": 6, "treble": 6, "input": 7, "stereo": 1, "output": 0, "mute": 0}
+        self.streaming = False
+
+    def handle(self, command, payload):
+        """Return the status and the response payload of a request."""
+        if command == ampproto.CMD_PING:
+            return (0x00, bytes([ampproto.PROTOCOL_VERSION])) if not payload else (0x02, b"")
+
+        if command == ampproto.CMD_GET:
+            return (0x00, bytes(self.settings.values())) if not payload else (0x02, b"")
+
+        if command == ampproto.CMD_SET:
+            if not payload or len(payload) % 2:
+                return 0x02, b""
+
+            # Whole batch is validated before any of the fields is changed.
+            changes = {}
+            for ident, value in zip(payload[0::2], payload[1::2]):
+                name, limit = LIMITS.get(ident, (None, -1))
+                if name is None or value > limit or (name == "input" and value < 2):
+                    return 0x03, b""
+                changes[name] = value
+
+            self.settings.update(changes)
+            return 0x00, b""
+
+        if command == ampproto.CMD_STREAM:
+            if len(payload) != 1:
+                return 0x02, b""
+            if payload[0] > 1:
+                return 0x03, b""
+            self.streaming = bool(payload[0])
+            return 0x00, b""
+
+        if command == ampproto.CMD_PROFILE:
+            if len(payload) != 1:
+                return 0x02, b""
+            if payload[0] == ampproto.PROFILE_SUMMARY:
+                return 0x00, struct.pack("<BHHbH", len(ampproto.PROFILE_STAGES), FRAME_RATE * 10, 250, 3, 2100)
+            if payload[0] >= len(ampproto.PROFILE_STAGES):
+                return 0x03, b""
+            ticks = 100 * (payload[0] + 1)
+            return 0x00, struct.pack("<HHHH", ticks, ticks + 10, ticks + 50, 1000)
+
+        if command == ampproto.CMD_PROFILE_RESET:
+            return 0x00, b""
+
+        return 0x01, b""
+
+
+def synthetic_bands(t):
+    """Pink-ish spectrum with a tone sweeping across the bands."""
+    peak = (math.sin(t * 0.5) + 1) * (COLUMNS - 1) / 2
+    return [min(0xFFFF, int(20000 / (band + 1) + 30000 * math.exp(-(band - peak) ** 2) + random.randint(0, 300)))
+            for band in range(COLUMNS)]
+
+
+def main():
+    master, slave = os.openpty()
+    tty.setraw(slave)
+    print(os.ttyname(slave), flush=True)
+
+    amp = FakeAmplifier()
+    parser = ampproto.FrameParser()
+    encoder = ampproto.SpectrumEncoder()
+    start_time = next_frame = time.monotonic()
+
+    while True:
+        timeout = max(0, next_frame - time.monotonic()) if amp.streaming else None
+        ready, _, _ = select.select([master], [], [], timeout)
+
+        if amp.streaming and time.monotonic() >= next_frame:
+            t = time.monotonic() - start_time
+            os.write(master, encoder.encode(synthetic_bands(t), int(t * 1000), random.randint(-8, 8)))
+            next_frame += 1.0 / FRAME_RATE
+
+        if not ready:
+            continue
+
+        for command, request_id, payload in parser.feed(os.read(master, 256)):
+            if command & ampproto.RESPONSE:
+                continue
+
+            was_streaming = amp.streaming
+            status, data = amp.handle(command, payload)
+            if amp.streaming and not was_streaming:
+                encoder.frames_to_key = 0
+                next_frame = time.monotonic()
+
+            if status != 0x00:
+                data = b""
+
+            os.write(master, ampproto.encode_frame(command | ampproto.RESPONSE, request_id, bytes([status]) + data))
+            print("cmd 0x%02X id %d -> status %d %s" % (command, request_id, status, amp.settings), file=sys.stderr, flush=True)
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except KeyboardInterrupt:
+        pass
@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+# Record the spectrum analyzer stream of the amplifier into a CSV file.
+#
+#   spectrumlog.py -p /dev/ttyUSB0 -o spectrum.csv -d 10
+#
+# Each row has the host time, device timestamp (ms), AGC gain (1/16 octave), number of frames
+# dropped by the device before the row and the band magnitudes. Frame rate is reported on stderr.
+# Frames are sent only while the analyzer is on the screen.
+
+import argparse
+import csv
+import os
+import sys
+import time
+
+import ampproto
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Arduino mini amplifier spectrum recorder.")
+    parser.add_argument("-p", "--port", required=True, help="serial device of the amplifier")
+    parser.add_argument("-b", "--baud", type=int, default=ampproto.BAUD_RATE)
+    parser.add_argument("-o", "--output", help="CSV file (default: stdout)")
+    parser.add_argument("-d", "--duration", type=float, help="recording time in seconds (default: until Ctrl+C)")
+    parser.add_argument("-r", "--report", type=float, default=1.0, help="frame rate report interval in seconds")
+    args = parser.parse_args()
+
+    fd = ampproto.open_port(args.port, args.baud)
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    writer = csv.writer(out)
+
+    amp = ampproto.Amplifier(fd)
+    decoder = ampproto.SpectrumDecoder()
+    columns = None
+    frames = total_frames = 0
+
+    start_time = report_time = time.monotonic()
+
+    try:
+        amp.stream(True)
+        pending = amp.discard_frames()
+
+        while args.duration is None or (time.monotonic() - start_time) < args.duration:
+            received = pending or ampproto.read_frames(fd, amp.parser, 0.1)
+            pending = []
+
+            for command, sequence, payload in received:
+                if command != ampproto.FRAME_SPECTRUM:
+                    continue
+
+                decoded = decoder.decode(sequence, payload)
+                if decoded is None:
+                    continue
+
+                timestamp, gain, dropped, bands = decoded
+                if columns is None:
+                    columns = len(bands)
+                    writer.writerow(["host_time", "device_ms", "gain", "dropped"] + ["band%d" % i for i in range(columns)])
+
+                writer.writerow(["%.6f" % (time.monotonic() - start_time), timestamp, gain, dropped] + bands)
+                frames += 1
+
+            now = time.monotonic()
+            if now - report_time >= args.report:
+                print("%.1f fps, dropped by device %d, lost on line %d, crc errors %d" %
+                      (frames / (now - report_time), decoder.dropped_frames, decoder.lost_frames, amp.parser.crc_errors),
+                      file=sys.stderr)
+                total_frames += frames
+                frames = 0
+                report_time = now
+    except KeyboardInterrupt:
+        pass
+    except ampproto.ProtocolError as error:
+        print("error: %s" % error, file=sys.stderr)
+        return 1
+    finally:
+        try:
+            amp.stream(False)
+        except ampproto.ProtocolError:
+            pass
+        os.close(fd)
+        if out is not sys.stdout:
+            out.close()
+
+    total_frames += frames
+    elapsed = time.monotonic() - start_time
+    print("%d frames in %.1f s (%.1f fps)" % (total_frames, elapsed, total_frames / elapsed if elapsed else 0), file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())